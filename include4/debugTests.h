@@ -108,6 +108,397 @@ void testAi(){
     exit_sim();
 }
 
+// Ensure the maintained population counters (popCounts) agree with a full scan of pActives
+void testPopulationCounts(int numFrames = 200){
+    init_sim_global_vals();
+    randomly_place_new_cells(50);
+    gen_dead_cell();
+    for(int i = 0; i < numFrames; i++){
+        do_frame();
+        int numAlive = count_all_alive_cells(pActives);
+        std::vector<int> numOfType(NUM_CELL_ARCHETYPES);
+        for(auto pCell : pActives){
+            assert(pCell->cellType == pCell->calc_cell_type());
+            numOfType[pCell->cellType]++;
+        }
+        assert(popCounts.numAlive == numAlive);
+        assert(popCounts.num_actives() == pActives.size());
+        for(int cellType = 0; cellType < NUM_CELL_ARCHETYPES; cellType++){
+            assert(popCounts.num_of_type(cellType) == numOfType[cellType]);
+        }
+    }
+    std::cout << "testPopulationCounts passed (" << popCounts.numAlive << " alive, " << popCounts.numDead << " dead)\n";
+    exit_sim();
+}
+
+// Every cell ever created should be in lineageLog, even after it has been removed and freed
+void testLineageLog(int numFrames = 200){
+    init_sim_global_vals();
+    randomly_place_new_cells(50);
+    for(int i = 0; i < numFrames; i++) do_frame();
+    assert(lineageLog.isOpen);
+    LineageRecord* pRecords = lineageLog.get_records();
+    std::set<int> activeCellNums;
+    for(auto pCell : pActives){
+        LineageRecord record = pRecords[pCell->uniqueCellNum];
+        assert(record.id == pCell->uniqueCellNum);
+        assert(record.parentId == pCell->parentId);
+        assert(record.parentId < record.id);
+        assert((record.deathFrame >= 0) == !pCell->isAlive);
+        activeCellNums.insert(pCell->uniqueCellNum);
+    }
+    int numRemoved = 0;
+    for(int cellNum = 0; cellNum < lineageLog.num_records(); cellNum++){
+        if(activeCellNums.count(cellNum)) continue;
+        // Only dead cells are ever removed
+        assert(pRecords[cellNum].deathFrame >= pRecords[cellNum].birthFrame);
+        numRemoved++;
+    }
+    std::cout << "testLineageLog passed (" << lineageLog.num_records() << " records, " << numRemoved << " removed)\n";
+    exit_sim();
+}
+
+// The int8 weights should round-trip to within half a step, and the int8 network should mostly decide like the float one
+void testQuantizedAi(int numFrames = 100){
+    AiBrain brain;
+    brain.init_brain({40, NUM_HIDDEN_LAYER_NODES, 6});
+    for(int layerNum = 1; layerNum < brain.num_layers(); layerNum++){
+        int numWeights = brain.num_weights_per_node(layerNum);
+        float scale = brain.qWeightScales[layerNum];
+        for(int nodeNum = 0; nodeNum < brain.num_nodes(layerNum); nodeNum++){
+            const float* pNode = brain.get_node_params(layerNum, nodeNum);
+            const int8_t* pQWeights = &brain.qWeights[brain.qLayerStart[layerNum] + nodeNum * numWeights];
+            for(int i = 0; i < numWeights; i++){
+                float weight = pNode[1 + ((layerNum == 1) ? brain.inputOrder[i] : i)];
+                assert(abs_float(weight - pQWeights[i] * scale) <= scale / 2 * 1.001);
+            }
+        }
+    }
+    int prevAiMode = aiMode;
+    aiMode = EVOLUTIONARY_NEURAL_NETWORK_AI_MODE;
+    aiInferenceMode = AI_INFERENCE_COMPARE;
+    aiQuantizationReport.clear();
+    init_sim_global_vals();
+    randomly_place_new_cells(100);
+    for(int i = 0; i < numFrames; i++) do_frame();
+    aiQuantizationReport.print();
+    // The int8 AI rounds the largest inputs (the energies) by ~1% of their scale, and the directions are whole degrees,
+    //  so about a third of the decisions differ. Much more than that means the quantized path is broken
+    assert(aiQuantizationReport.numDecisions > 0);
+    assert(aiQuantizationReport.numDifferentDecisions < 0.4 * aiQuantizationReport.numDecisions);
+    assert(aiQuantizationReport.sumAbsError / aiQuantizationReport.numOutputs < 20);
+    aiQuantizationReport.clear();
+    aiMode = prevAiMode;
+    aiInferenceMode = AI_INFERENCE_FLOAT;
+    std::cout << "testQuantizedAi passed\n";
+    exit_sim();
+}
+
+// Sorting the cell storage should lay the cells out in Morton order, and the simulation should go on as usual after
+void testCellStorageSort(int numFrames = 200){
+    init_sim_global_vals();
+    randomly_place_new_cells(200, CELL_TYPE_PLANT);
+    randomly_place_new_cells(50);
+    for(int i = 0; i < numFrames; i++){
+        do_frame();
+        if(i % 10 != 0) continue;
+        sort_cell_storage();
+        assign_cells_to_correct_regions();
+        // Walking through memory now walks along the curve
+        std::vector<Cell*> pCells = pActives;
+        std::sort(pCells.begin(), pCells.end());
+        for(int j = 1; j < pCells.size(); j++){
+            assert(calc_morton_code(pCells[j-1]->posX, pCells[j-1]->posY) <= calc_morton_code(pCells[j]->posX, pCells[j]->posY));
+        }
+        for(auto pCell : pActives) assert(pCell->pSelf == pCell);
+    }
+    std::cout << "testCellStorageSort passed (" << pActives.size() << " cells, " << cellPool.blocks.size() << " blocks)\n";
+    exit_sim();
+}
+
+// Searching through the blocks of regions with cells should find the same cells as searching through every region,
+//  including for boxes which wrap around the map or cover all of it
+void testRegionCounts(int numFrames = 20){
+    int prevUbX = ubX.val, prevUbY = ubY.val;
+    ubX.set_val(4000); ubY.set_val(4000);
+    init_sim_global_vals();
+    randomly_place_new_cells(100, CELL_TYPE_PLANT);
+    randomly_place_new_cells(100, CELL_TYPE_PREDATOR);
+    int64_t numRegionsVisited = 0, numRegionsInBoxes = 0;
+    for(int i = 0; i < numFrames; i++){
+        do_frame();
+        assign_cells_to_correct_regions();
+        WorldView world = get_world_view(), slowWorld(pActivesRegions);
+        for(auto pCell : pActives){
+            int radiusInRegions = rand() % (cellRegionNumUbX / 2 + 2);
+            std::tuple<int, int, int, int> bounds = pCell->get_xyRegion_neighborhoodBounds(radiusInRegions);
+            int xRegLb = std::get<0>(bounds), yRegLb = std::get<2>(bounds);
+            int numRegX = (std::get<1>(bounds) - xRegLb + cellRegionNumUbX) % cellRegionNumUbX + 1;
+            int numRegY = (std::get<3>(bounds) - yRegLb + cellRegionNumUbY) % cellRegionNumUbY + 1;
+            std::vector<Cell*> pFound, pExpected;
+            world.for_each_region(xRegLb, numRegX, yRegLb, numRegY, [&](std::pair<int,int> reg){
+                ConstSpan<Cell*> pCells = world.cells_in_region(reg);
+                pFound.insert(pFound.end(), pCells.begin(), pCells.end());
+                numRegionsVisited++;
+            });
+            slowWorld.for_each_region(xRegLb, numRegX, yRegLb, numRegY, [&](std::pair<int,int> reg){
+                ConstSpan<Cell*> pCells = slowWorld.cells_in_region(reg);
+                pExpected.insert(pExpected.end(), pCells.begin(), pCells.end());
+            });
+            std::sort(pFound.begin(), pFound.end());
+            std::sort(pExpected.begin(), pExpected.end());
+            assert(pFound == pExpected);
+            numRegionsInBoxes += (int64_t)numRegX * numRegY;
+        }
+    }
+    std::cout << "testRegionCounts passed (" << numRegionsVisited << " of " << numRegionsInBoxes << " regions visited, "
+        << pActivesRegionCounts.levels.size() << " levels of blocks of " << pActivesRegionCounts.get_base_side_len() << " regions)\n";
+    exit_sim();
+    ubX.set_val(prevUbX); ubY.set_val(prevUbY);
+    update_global_params();
+}
+
+// Every task should run once, after the tasks it depends on, and pinned tasks should run on the calling thread
+void testTaskGraph(int numRuns = 1000){
+    TaskGraph graph;
+    std::atomic<int> numFinished{0};
+    std::vector<int> finishOrder(64, -1);
+    std::thread::id callerId = std::this_thread::get_id();
+    for(int run = 0; run < numRuns; run++){
+        graph.clear();
+        numFinished = 0;
+        std::fill(finishOrder.begin(), finishOrder.end(), -1);
+        // Each task depends on up to 2 random earlier tasks
+        std::vector<std::pair<int,int>> deps;
+        for(int id = 0; id < finishOrder.size(); id++){
+            int dep1 = id > 0 ? rand() % id : -1, dep2 = id > 1 ? rand() % id : -1;
+            if(rand() % 4 == 0) dep1 = -1;
+            if(rand() % 2 == 0) dep2 = -1;
+            if(dep2 == dep1) dep2 = -1;
+            deps.push_back({dep1, dep2});
+            bool isPinned = rand() % 2;
+            graph.add("test", [&, id, isPinned, callerId]{
+                assert(!isPinned || std::this_thread::get_id() == callerId);
+                assert(finishOrder[id] == -1);
+                finishOrder[id] = numFinished++;
+            }, {dep1, dep2}, isPinned);
+        }
+        graph.run();
+        for(int id = 0; id < finishOrder.size(); id++){
+            assert(finishOrder[id] >= 0);
+            if(deps[id].first >= 0) assert(finishOrder[deps[id].first] < finishOrder[id]);
+            if(deps[id].second >= 0) assert(finishOrder[deps[id].second] < finishOrder[id]);
+        }
+    }
+    taskPool.stop();
+    std::cout << "testTaskGraph passed (" << numRuns << " graphs of " << finishOrder.size() << " tasks on " << NUM_TASK_THREADS << " threads)\n";
+}
+
+// A very large map should only allocate the chunks of ground and regions that something happens in
+void testWorldGrid(int numFrames = 50){
+    int prevUbX = ubX.val, prevUbY = ubY.val;
+    ubX.set_val(16000); ubY.set_val(16000);
+    init_sim_global_vals();
+    assert(simGndEnergy.num_allocated_chunks() == 0);
+    randomly_place_new_cells(50, CELL_TYPE_WORM);
+    randomly_place_new_cells(50, CELL_TYPE_PREDATOR);
+    for(int i = 0; i < numFrames; i++) do_frame();
+    assign_cells_to_correct_regions();
+    for(auto pCell : pActives){
+        const std::vector<Cell*>* pRegion = pActivesRegions.find(pCell->xyRegion);
+        assert(pRegion != NULL && std::count(pRegion->begin(), pRegion->end(), pCell) == 1);
+    }
+    int numGndChunks = simGndEnergy.numChunksX * simGndEnergy.numChunksY;
+    int numRegionChunks = pActivesRegions.numChunksX * pActivesRegions.numChunksY;
+    assert(simGndEnergy.num_allocated_chunks() <= numGndChunks / 10);
+    std::cout << "testWorldGrid passed (" << simGndEnergy.num_allocated_chunks() << " of " << numGndChunks << " ground chunks and "
+        << pActivesRegions.num_allocated_chunks() << " of " << numRegionChunks << " region chunks are allocated)\n";
+    exit_sim();
+    ubX.set_val(prevUbX); ubY.set_val(prevUbY);
+    update_global_params();
+}
+
+// Cells with the same stats should share one genome record
+void testSharedGenomes(){
+    init_sim_global_vals();
+    randomly_place_new_cells(50, CELL_TYPE_PLANT);
+    for(auto pCell : pActives) assert(pCell->stats.pRecord == pActives[0]->stats.pRecord);
+    Cell* pParent = pActives[0];
+    Cell* pClone = pParent->clone_self(lineageLog.next_id(), pActivesRegions, pActives, -1, false, false, false);
+    assert(pClone->stats.pRecord == pParent->stats.pRecord);
+    // Changing a stat copies the record, and changing it back shares the original again
+    int initEnergy = pClone->stats["initEnergy"][0];
+    pClone->set_initEnergy(initEnergy + 1, false);
+    assert(pClone->stats.pRecord != pParent->stats.pRecord);
+    assert(pParent->stats["initEnergy"][0] == initEnergy);
+    pClone->set_initEnergy(initEnergy, false);
+    pClone->enforce_valid_cell(true);
+    assert(pClone->stats.pRecord == pParent->stats.pRecord);
+    std::cout << "testSharedGenomes passed (" << genomePool.num_records() << " records for " << pActives.size() << " cells)\n";
+    exit_sim();
+}
+
+// Clones should share their parent's brain until one of them changes it
+void testSharedBrains(){
+    init_sim_global_vals();
+    randomly_place_new_cells(1, CELL_TYPE_PREDATOR);
+    Cell* pParent = pActives[0];
+    Cell* pClone = pParent->clone_self(lineageLog.next_id(), pActivesRegions, pActives, -1, false, false, false);
+    assert(pClone->pBrain == pParent->pBrain);
+    std::vector<float> parentParams = pParent->pBrain->params;
+    pClone->stats.set("mutationRate", 0, pClone->stats["mutationRate"][2]); // Mutate every bias and weight
+    pClone->mark_stats_changed();
+    pClone->mutate_ai();
+    assert(pClone->pBrain != pParent->pBrain);
+    assert(pParent->pBrain->params == parentParams);
+    assert(pClone->pBrain->params != parentParams);
+    assert(pParent->pBrain.use_count() == 1);
+    std::cout << "testSharedBrains passed (" << parentParams.size() << " parameters per brain)\n";
+    exit_sim();
+}
+
+// Sleeping cells reuse their contacts, which should always match a full search
+void testSleepingContacts(int numFrames = 200){
+    init_sim_global_vals();
+    randomly_place_new_cells(200, CELL_TYPE_PLANT);
+    randomly_place_new_cells(20);
+    int numAsleep = 0, numChecked = 0;
+    for(int i = 0; i < numFrames; i++){
+        do_frame();
+        update_contact_list();
+        ContactList searched;
+        searched.clear(pActives.size());
+        WorldView world = get_world_view();
+        for(auto pCell : pActives) pCell->find_contacts(world, searched);
+        assert(searched.firstContact == contactList.firstContact);
+        for(int j = 0; j < searched.contacts.size(); j++){
+            const Contact& a = searched.contacts[j];
+            const Contact& b = contactList.contacts[j];
+            assert(a.pOther == b.pOther && a.dX == b.dX && a.dY == b.dY && a.flags == b.flags);
+        }
+        for(auto pCell : pActives) numAsleep += pCell->isAsleep;
+        numChecked += pActives.size();
+    }
+    std::cout << "testSleepingContacts passed (" << numAsleep << " of " << numChecked << " cells were asleep)\n";
+    exit_sim();
+}
+
+// The cached vision lists should find the same cells in the same order as searching every region in sight
+void testVisionLists(int numFrames = 200){
+    init_sim_global_vals();
+    randomly_place_new_cells(200, CELL_TYPE_PLANT);
+    randomly_place_new_cells(20);
+    int numRebuilt = 0, numChecked = 0;
+    for(int i = 0; i < numFrames; i++){
+        do_frame();
+        assign_cells_to_correct_regions();
+        update_vision_lists();
+        WorldView world = get_world_view();
+        WorldView visionWorld = world;
+        visionWorld.pVisionLists = &visionLists;
+        for(auto pCell : pActives){
+            int prevGeneration = pCell->visionListGeneration, prevX = pCell->visionListX, prevY = pCell->visionListY;
+            assert(pCell->get_nearest_cells(100, visionWorld) == pCell->get_nearest_cells(100, world));
+            numRebuilt += (pCell->visionListGeneration != prevGeneration || pCell->visionListX != prevX || pCell->visionListY != prevY);
+        }
+        numChecked += pActives.size();
+    }
+    std::cout << "testVisionLists passed (" << numRebuilt << " of " << numChecked << " queries rebuilt their list)\n";
+    exit_sim();
+}
+
+// Chasing cells should pick the same target from preyIndex as from all the cells they see
+void testPreyIndex(int numFrames = 200){
+    init_sim_global_vals();
+    randomly_place_new_cells(200, CELL_TYPE_PLANT);
+    randomly_place_new_cells(50, CELL_TYPE_PREDATOR);
+    randomly_place_new_cells(50);
+    int numFound = 0, numChecked = 0;
+    for(int i = 0; i < numFrames; i++){
+        do_frame();
+        assign_cells_to_correct_regions();
+        update_prey_index();
+        WorldView world = get_world_view();
+        WorldView preyWorld = world;
+        preyWorld.pPreyIndex = &preyIndex;
+        for(auto pCell : pActives){
+            if(!pCell->isAlive) continue;
+            Cell* pTarget = NULL;
+            bool isFound = pCell->find_prey_in_index(100, preyWorld, pTarget);
+            if(isFound) assert(pTarget == pCell->find_optimal_prey(pCell->get_nearest_cells(100, world)));
+            numFound += isFound;
+            numChecked++;
+        }
+    }
+    std::cout << "testPreyIndex passed (" << numFound << " of " << numChecked << " targets were found in the index)\n";
+    exit_sim();
+}
+
+// Replaying a decision log should reproduce the recorded run exactly
+void testDecisionLog(int numFrames = 200){
+    bool isStillReplaying = false;
+    auto run_sim = [numFrames, &isStillReplaying](int _decisionLogMode){
+        decisionLogMode = _decisionLogMode;
+        initNumCells.set_val(50);
+        simState = SIM_STATE_INIT;
+        init_sim();
+        for(int i = 0; i < numFrames; i++){
+            step_sim();
+            frameNum++;
+        }
+        isStillReplaying = decisionLog.is_replaying();
+        std::vector<std::vector<int>> cellStates;
+        for(auto pCell : pActives){
+            cellStates.push_back({pCell->uniqueCellNum, pCell->posX, pCell->posY, pCell->energy, pCell->health,
+                pCell->isAlive, pCell->age, pCell->speedDir, pCell->speedMode, pCell->cloningDirection});
+        }
+        decisionLog.close();
+        deallocate_all_cells();
+        return cellStates;
+    };
+    std::vector<std::vector<int>> recorded = run_sim(DECISION_LOG_RECORD);
+    std::vector<std::vector<int>> replayed = run_sim(DECISION_LOG_REPLAY);
+    assert(recorded == replayed);
+    // A log which ends in the middle of the last frame stops there, and the cells which are left decide for themselves
+    FILE* pFile = fopen(DECISION_LOG_PATH, "rb");
+    std::vector<char> bytes;
+    for(int byte = getc(pFile); byte != EOF; byte = getc(pFile)) bytes.push_back(byte);
+    fclose(pFile);
+    pFile = fopen(DECISION_LOG_PATH, "wb");
+    fwrite(bytes.data(), 1, bytes.size() - sizeof(uint32_t) - 2, pFile); // The seed and part of the decisions
+    fclose(pFile);
+    std::vector<std::vector<int>> truncated = run_sim(DECISION_LOG_REPLAY);
+    assert(!isStillReplaying);
+    for(auto& cellState : truncated) assert(IDLE_MODE <= cellState[8] && cellState[8] <= RUN_MODE);
+    decisionLogMode = DECISION_LOG_OFF;
+    std::cout << "testDecisionLog passed (" << recorded.size() << " cells after " << numFrames << " frames)\n";
+    simState = SIM_STATE_QUIT;
+    exit_sim();
+}
+
+// The compile-time trig tables and the fixed-point motion steps should match the libm-based math exactly
+void testMotionSteps(){
+    for(int deg = 0; deg < 360; deg++){
+        assert(TRIG_TABLE.sinVals[deg] == (float)sin(deg * PI / 180));
+        assert(TRIG_TABLE.cosVals[deg] == (float)cos(deg * PI / 180));
+    }
+    std::vector<int> speeds, dirs;
+    for(int speed = -1; speed <= MOTION_MAX_EXACT_SPEED; speed++){
+        for(int deg = 0; deg < 360; deg++){
+            speeds.push_back(speed);
+            dirs.push_back(deg);
+        }
+    }
+    int numSteps = speeds.size();
+    std::vector<int> stepsX(numSteps), stepsY(numSteps);
+    calc_motion_steps(speeds.data(), dirs.data(), stepsX.data(), stepsY.data(), numSteps);
+    for(int i = 0; i < numSteps; i++){
+        assert(stepsX[i] == (int)(speeds[i] * (float)cos(dirs[i] * PI / 180)));
+        assert(stepsY[i] == (int)(speeds[i] * (float)sin(dirs[i] * PI / 180)));
+    }
+    std::cout << "testMotionSteps passed (" << numSteps << " steps)\n";
+}
+
 // A function devoted to testing the application of forces to a cell
 void testForce(){
     std::cout << "Need ubX.val = 100 and ubY.val = 100 ";
@@ -120,7 +511,8 @@ void testForce(){
     for (int i = 0; i < numCells; i++) {
         if(pActives[i]->isAlive == false) continue;
         pActives[i]->speedMode = IDLE_MODE;
-        pActives[i]->stats["dia"][0] = 1;
+        pActives[i]->stats.set("dia", 0, 1);
+        pActives[i]->mark_stats_changed();
         pActives[i]->update_size();
     }
 
@@ -137,7 +529,8 @@ void testForce(){
     if(DO_DIA_10_TESTS){
         std::cout << "Testing a diameter of 10\n";
         for (int i = 0; i < numCells; i++) {
-            pActives[i]->stats["dia"][0] = 10;
+            pActives[i]->stats.set("dia", 0, 10);
+            pActives[i]->mark_stats_changed();
             pActives[i]->update_size();
         }
         pActives[0]->update_pos(30, 30); pActives[1]->update_pos(30, 30);
@@ -312,14 +705,13 @@ void test_cur_tex(){
 // Change an existing texture and draw it at its (possibly) new x and y position
 void redraw_existing_tex(){
     // xPos = 0, yPos = 0 refers to the top left corner of the window
-    // Not sure what pSrc refers to.
-    //  pSrc may represent the original object, but I'm not sure
-    //  If pSrc == NULL, then a new texture is rendered
+    // pSrc is the part of the texture to draw (here, the symbol's place in texAtlas)
     // pDst represents the new object
     //  If dst == NULL, then the texture fills the entire window
 
     // Inputs
-    SDL_Texture* pTexture = p_V_Symbol;
+    SDL_Texture* pTexture = texAtlas.get_texture();
+    const SDL_Rect* pSrc = &p_V_Symbol->srcRect;
     int xPos = 12*drawScaleFactor, yPos = 10*drawScaleFactor;
     int width = 5*drawScaleFactor, height = 10*drawScaleFactor;
 
@@ -327,10 +719,8 @@ void redraw_existing_tex(){
     SDL_Rect* pDst = new SDL_Rect;
     pDst->x = xPos; pDst->y = yPos;
     pDst->h = height; pDst->w = width;
-    //SDL_RenderCopy(pRenderer, pTexture, pSrc, pDst);
-    SDL_RenderCopy(P_RENDERER, pTexture, NULL, pDst);
+    SDL_RenderCopy(P_RENDERER, pTexture, pSrc, pDst);
     //  This renders the opject according to pDst
-    //  I could replace NULL with pSrc, but I don't know what pSrc refers to
 
     // Post-function necessities
     SDL_RenderPresent(P_RENDERER);
@@ -345,7 +735,7 @@ void redraw_existing_tex(){
             case SDL_MOUSEMOTION:
             mouseClickType = SDL_GetMouseState(&mousePosX, &mousePosY);
             pDst->x = mousePosX; pDst->y = mousePosY;
-            SDL_RenderCopy(P_RENDERER, pTexture, NULL, pDst);
+            SDL_RenderCopy(P_RENDERER, pTexture, pSrc, pDst);
             SDL_RenderPresent(P_RENDERER);
             enforce_frame_rate(frameStart, FRAME_DELAY);
             count++;
@@ -4,5 +4,6 @@
 #endif
 
 #include "sim.h"
+#include "renderThread.h"
 #include "debugTests.h"
 #include "videoFrames.h"
\ No newline at end of file
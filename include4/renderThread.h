@@ -0,0 +1,107 @@
+// Runs the simulation on its own thread while the main thread renders and handles events
+//  NOTE: SDL has to stay on the main thread. The simulation thread never calls SDL and the main thread
+//  never touches the cells. They only communicate through renderSnapshots and uiCommands
+#ifndef SIM_H
+#include "sim.h"
+#endif
+
+
+// The simulation thread publishes a snapshot after every frame. The main thread draws the latest one
+TripleBuffer<RenderSnapshot> renderSnapshots;
+// Commands from the main thread to the simulation thread
+SpscQueue<UiCommand, 64> uiCommands;
+
+void run_sim_thread(){
+    int numFramesToRun = 1; // Like do_frame(), the first frame runs right away
+    bool isPaused = false; // e.g. while the options menu is open
+    while(true){
+        UiCommand command;
+        while(uiCommands.pop(command)){
+            switch(command.type){
+                case UI_CMD_STEP:
+                case UI_CMD_SKIP:
+                numFramesToRun = command.numFrames;
+                break;
+                case UI_CMD_OPTIONS:
+                isPaused = true;
+                break;
+                case UI_CMD_CONTINUE:
+                isPaused = false;
+                break;
+                case UI_CMD_QUIT:
+                return;
+            }
+        }
+        if(isPaused || numFramesToRun == 0){
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        // The snapshot is part of the frame, so the cells are copied while the ground regenerates. The main thread
+        //  draws it while the next frame runs, i.e. the drawing is always one frame behind the simulation
+        RenderSnapshot& snapshot = renderSnapshots.get_back();
+        int iCellsDone, iGndDone;
+        build_frame_graph(frameGraph, true, iCellsDone, iGndDone);
+        frameGraph.add("snapshotCells", [&]{ take_cell_snapshots(snapshot); }, {iCellsDone}, false);
+        frameGraph.add("snapshotWorld", [&]{ take_world_snapshot(snapshot); }, {iCellsDone, iGndDone}, false);
+        frameGraph.run();
+        frameNum++;
+        numFramesToRun--;
+        if(popCounts.num_actives() == 0) numFramesToRun = 0;
+        snapshot.frameNum = frameNum;
+        renderSnapshots.publish();
+    }
+}
+
+// Used instead of do_frame() when DECOUPLE_RENDERING is true. Returns once the user quits or restarts
+void run_decoupled_sim(){
+    assert(simState == SIM_STATE_STEP_FRAMES || simState == SIM_STATE_SKIP_FRAMES);
+    simState = SIM_STATE_STEP_FRAMES;
+    // The simulation thread is not running yet, so the first snapshot can be taken here
+    take_render_snapshot(renderSnapshots.get_back());
+    renderSnapshots.publish();
+    std::thread simThread(run_sim_thread);
+
+    SDL_Event windowEvent;
+    bool pauseSim = true;
+    while(simState == SIM_STATE_STEP_FRAMES){
+        Uint32 displayFrameStart = SDL_GetTicks();
+        while(simState == SIM_STATE_STEP_FRAMES && SDL_PollEvent(&windowEvent)){
+            UiCommand command = get_ui_command(windowEvent);
+            switch(command.type){
+                case UI_CMD_STEP:
+                uiCommands.push(command);
+                break;
+                case UI_CMD_SKIP:
+                std::cout << command.key << " is pressed! Simulation is speeding up for " << command.numFrames << " frames" << endl;
+                uiCommands.push(command);
+                break;
+                case UI_CMD_OPTIONS:
+                uiCommands.push(command);
+                simState = SIM_STATE_OPTIONS;
+                run_sim_state_options_menu(windowEvent, pauseSim, simState); // Blocks until an option is picked
+                if(simState == SIM_STATE_STEP_FRAMES){
+                    command.type = UI_CMD_CONTINUE;
+                    uiCommands.push(command);
+                }
+                break;
+                case UI_CMD_QUIT:
+                simState = SIM_STATE_QUIT;
+                break;
+            }
+        }
+        if(simState != SIM_STATE_STEP_FRAMES) break;
+
+        // Draw the latest frame at the display rate, however fast the simulation is running
+        renderSnapshots.update_front();
+        SDL_RenderClear(P_RENDERER);
+        draw_render_snapshot(renderSnapshots.get_front());
+        enforce_frame_rate(displayFrameStart, FRAME_DELAY);
+        SDL_RenderPresent(P_RENDERER);
+    }
+
+    // Quitting and restarting both free the cells, so the simulation thread has to stop first
+    UiCommand quitCommand;
+    quitCommand.type = UI_CMD_QUIT;
+    while(!uiCommands.push(quitCommand)) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    simThread.join();
+}
@@ -11,22 +11,100 @@
 
 
 // Create an empty vector of pointers to Cells and DeadCells as global variables
-std::vector<Cell*> pCellsHist; // A history of all cells in the order they were created
 std::vector<Cell*> pActives; // All the dead and alive cells in the simulation
-std::map<std::pair<int,int>, std::vector<Cell*>> pActivesRegions; // pActives separated by region
+RegionGrid<std::vector<Cell*>> pActivesRegions; // pActives separated by region
+RegionCounts pActivesRegionCounts; // The number of cells in each block of pActivesRegions
+// Births requested during the interaction phase, one buffer per simulation thread
+std::vector<std::vector<SpawnRequest>> spawnBuffers(NUM_SIM_THREADS);
+// Every pair of cells which touch or repel each other (see update_contact_list())
+ContactList contactList;
+// What every cell looked like when contactList was last built, indexed by the cell's iContacts at the time
+//  update_contact_list() compares against this to find the cells which can keep their contacts
+struct ContactListHistory {
+    ContactList contactList;
+    std::vector<Cell*> pCells;
+    std::vector<int> cellNums, posXs, posYs, dias, regions;
+    std::vector<char> isAlive;
+
+    void clear(){
+        contactList.clear(0);
+        pCells.clear(); cellNums.clear(); posXs.clear(); posYs.clear(); dias.clear(); regions.clear(); isAlive.clear();
+    }
+    // The index the cell had in the last contact list, or -1 if it was not in it
+    //  (cells are compared by id too, since a new cell may reuse the memory of a removed one)
+    int find_cell(Cell* pCell){
+        int i = pCell->iContacts;
+        if(i < 0 || i >= pCells.size() || pCells[i] != pCell || cellNums[i] != pCell->uniqueCellNum) return -1;
+        return i;
+    }
+};
+ContactListHistory contactListHistory;
+// The cached vision queries of the decision phase (see update_vision_lists())
+VisionLists visionLists;
+// The cells each chasing cell may pick as its target during the decision phase (see update_prey_index())
+PreyIndex preyIndex;
+
+// Cell methods only read the world through this view (see WorldView)
+WorldView get_world_view(){
+    WorldView world(pActivesRegions, &contactList);
+    world.pRegionCounts = &pActivesRegionCounts;
+    return world;
+}
+// Only the cells in pActives are still in memory (lineageLog records the rest), so this returns NULL for removed cells
+//  NOTE: This is a linear search meant for scripted scenarios (e.g. in videoFrames.h)
+Cell* get_cell_by_id(int cellId){
+    for(auto pCell : pActives){
+        if(pCell->uniqueCellNum == cellId) return pCell;
+    }
+    return NULL;
+}
 
 
 
 void do_video1();
+void run_decoupled_sim();
 
 
-int count_all_alive_cells(std::vector<Cell*> pActives){
+// NOTE: Use popCounts.numAlive instead. This full scan is only kept to verify popCounts
+int count_all_alive_cells(const std::vector<Cell*>& pActives){
     int numAliveCells = 0;
     for(auto pCell : pActives) numAliveCells += pCell->isAlive;
     return numAliveCells;
-}  
+}
 
 
+// A copy of everything SDL_draw_frame() draws, so another thread can draw it while the simulation keeps running
+struct RenderSnapshot {
+    int frameNum = 0;
+    int numAlive = 0;
+    int energyFromSunPerSec = 0;
+    GndEnergyGrid gndEnergy; // Shares its chunks with simGndEnergy until they change
+    std::vector<CellSnapshot> cells;
+};
+// NOTE: snapshot is reused (rather than reallocated) from frame to frame
+// The two halves of take_render_snapshot(...), so the cells can be copied while the ground is still changing
+void take_cell_snapshots(RenderSnapshot& snapshot){
+    snapshot.cells.resize(pActives.size());
+    for(int i = 0; i < pActives.size(); i++) snapshot.cells[i] = pActives[i]->get_snapshot();
+}
+void take_world_snapshot(RenderSnapshot& snapshot){
+    snapshot.numAlive = popCounts.numAlive;
+    snapshot.energyFromSunPerSec = energyFromSunPerSec;
+    snapshot.gndEnergy = simGndEnergy;
+}
+void take_render_snapshot(RenderSnapshot& snapshot){
+    snapshot.frameNum = frameNum;
+    take_cell_snapshots(snapshot);
+    take_world_snapshot(snapshot);
+}
+void draw_render_snapshot(const RenderSnapshot& snapshot){
+    draw_bkgnd(snapshot.energyFromSunPerSec);
+    draw_gnd(snapshot.gndEnergy);
+    for(auto& cell : snapshot.cells) draw_cell_snapshot(cell);
+    draw_cell_mask(snapshot.gndEnergy);
+    draw_user_interface(snapshot.numAlive, snapshot.frameNum);
+}
+
 // Render the background, cell positions, etc using SDL
 void SDL_draw_frame(){
     SDL_RenderClear(P_RENDERER);
@@ -78,16 +156,19 @@ void SDL_draw_frame(){
 
     draw_texture(p_D_Symbol, ds, 4*dsSymVert + ds, (int)symbolWidth*5, (int)symbolHeight*5);
 
-    draw_user_interface(count_all_alive_cells(pActives));
+    draw_user_interface(popCounts.numAlive);
     #else
     //SDL_RenderClear(P_RENDERER);
+    // Drawn on the simulation's own thread, so there is no need to copy anything into a RenderSnapshot first
     draw_bkgnd(energyFromSunPerSec);
     draw_gnd();
     for(auto pCell : pActives) pCell->draw_cell();
     draw_cell_mask();
-    draw_user_interface(count_all_alive_cells(pActives));
+    draw_user_interface(popCounts.numAlive);
     #endif
+    #ifndef DO_OFFSCREEN_VIDEO
     enforce_frame_rate(frameStart, FRAME_DELAY);
+    #endif
     SDL_RenderPresent(P_RENDERER);
 }
 
@@ -100,19 +181,11 @@ void deallocate_cell_memory(Cell* pCell) {
 
 void init_sim_gnd_energy(int initGndEnergy){
     if(initGndEnergy < 0) initGndEnergy = maxGndEnergy.val / 2;
-    simGndEnergy.clear();
-    std::vector<int> simGndEnergyRow(ubX.val);
-    for(int posX = 0; posX < ubX.val; posX++) simGndEnergyRow[posX] = initGndEnergy;
-    for(int posY = 0; posY < ubY.val; posY++) simGndEnergy.push_back(simGndEnergyRow);
+    simGndEnergy.init(ubX.val, ubY.val, maxGndEnergy.val, initGndEnergy);
 }
 
 void increase_sim_gnd_energy(int increaseAmt){
-    for(int posY = 0; posY < simGndEnergy.size(); posY++){
-        for(int posX = 0; posX < simGndEnergy[posY].size(); posX++){
-            simGndEnergy[posY][posX] += increaseAmt;
-            simGndEnergy[posY][posX] = min_int(simGndEnergy[posY][posX], maxGndEnergy.val);
-        }
-    }
+    simGndEnergy.add_to_all(increaseAmt, maxGndEnergy.val);
 }
 
 // If the target is set to a positive time, then set the time.
@@ -163,19 +236,66 @@ void init_sim_global_vals(){
     init_sim_gnd_energy(maxGndEnergy.val / 2);
 }
 
-// This function allocates memory for a new cell and saves a pointer to it in both pCellsHist and pActives
+// This function allocates memory for a new cell, saves a pointer to it in pActives, and records it in lineageLog
 void gen_cell(int cellType, Cell* pParent = NULL, bool randomizeCloningDir = false, int cloningDir = -1){
     if(cellType == CELL_TYPE_PLANT_WORM_PREDATOR_OR_MUTANT) cellType = availableCellTypes(rng);
     //cout << "cellType: " << cellType << endl;
     if(pParent == NULL){
         Cell *pCell = new Cell();
-        pCell->define_self(pCellsHist.size(), pCell, NULL);
-        pCellsHist.push_back(pCell);
+        pCell->define_self(lineageLog.next_id(), pCell);
         pActives.push_back(pCell);
-        pCell->gen_stats_random(cellType, pActivesRegions, pCellsHist);
+        pCell->gen_stats_random(cellType, get_world_view());
         pCell->randomize_pos(0, ubX.val-1, 0, ubY.val-1);
+        pCell->register_population();
+        pCell->record_birth();
     } else {
-        Cell* pCell = pParent->clone_self(pCellsHist.size(), pActivesRegions, pCellsHist, pActives, cloningDir, randomizeCloningDir);
+        Cell* pCell = pParent->clone_self(lineageLog.next_id(), pActivesRegions, pActives, cloningDir, randomizeCloningDir);
+    }
+}
+
+int count_pending_spawns(){
+    int numPending = 0;
+    for(auto& spawnBuffer : spawnBuffers) numPending += spawnBuffer.size();
+    return numPending;
+}
+
+// Create every clone requested since the last commit in one batch: id assignment,
+//  placement, mutation, insertion into pActives, and recording in lineageLog.
+//  The requests are sorted by orderKey, so the result does NOT depend on which thread
+//  (i.e. which buffer) recorded each birth
+void commit_spawn_buffers(){
+    std::vector<SpawnRequest> pending;
+    for(auto& spawnBuffer : spawnBuffers){
+        pending.insert(pending.end(), spawnBuffer.begin(), spawnBuffer.end());
+        spawnBuffer.clear();
+    }
+    if(pending.size() == 0) return;
+    std::stable_sort(pending.begin(), pending.end(), [](const SpawnRequest& left, const SpawnRequest& right){
+        return left.orderKey < right.orderKey;
+    });
+    pActives.reserve(pActives.size() + pending.size());
+    for(auto& request : pending){
+        request.pParent->clone_self(lineageLog.next_id(), pActivesRegions, pActives, request.cloningDir, false, true, false);
+    }
+}
+
+// Same as calling update_target_pos() for every cell, except that the steps
+//  for all cells are calculated in one pass by calc_motion_steps(...)
+void update_target_positions(){
+    static std::vector<int> speeds, dirs, stepsX, stepsY;
+    int numCells = pActives.size();
+    speeds.resize(numCells); dirs.resize(numCells);
+    stepsX.resize(numCells); stepsY.resize(numCells);
+    for(int i = 0; i < numCells; i++){
+        pActives[i]->correct_speedDir();
+        speeds[i] = pActives[i]->get_speed();
+        dirs[i] = pActives[i]->speedDir;
+    }
+    calc_motion_steps(speeds.data(), dirs.data(), stepsX.data(), stepsY.data(), numCells);
+    for(int i = numCells-1; i >= 0; i--){
+        if(speeds[i] == 0) continue;
+        if(abs(speeds[i]) > MOTION_MAX_EXACT_SPEED) pActives[i]->update_target_pos();
+        else pActives[i]->increment_pos(stepsX[i], stepsY[i]);
     }
 }
 
@@ -213,13 +333,22 @@ void print_cell_forces(std::vector<Cell*> pCells){
 // Deallocate all cell pointers and then remove the deallocated pointers from
 //  the vectors, maps, etc. that they are stored in
 void deallocate_all_cells(){
-    for(auto pCell : pCellsHist) delete pCell;
-    pCellsHist.clear(); pActives.clear();
+    for(auto pCell : pActives) delete pCell; // Removed cells were already freed
+    for(auto& spawnBuffer : spawnBuffers) spawnBuffer.clear();
+    pActives.clear();
+    lineageLog.reset();
+    popCounts.clear();
     pActivesRegions.clear();
+    pActivesRegionCounts.clear();
+    contactList.clear(0);
+    contactListHistory.clear();
+    visionLists.clear();
+    preyIndex.clear();
 }
 // Initialize the simulation
 void init_sim(){
     assert(simState == SIM_STATE_INIT);
+    decisionLog.begin(decisionLogMode, DECISION_LOG_PATH); // Replaying restores the recorded parameters
     update_global_params();
     init_sim_global_vals();
     randomly_place_new_cells(initNumCells.val);
@@ -232,12 +361,18 @@ void restart_sim(){
     assert(simState == SIM_STATE_RESTART);
     // Deallocate and remove all cells from the simulation
     deallocate_all_cells();
+    decisionLog.close();
+    aiQuantizationReport.print();
+    aiQuantizationReport.clear();
     simState = SIM_STATE_MAIN_MENU; //SIM_STATE_STEP_FRAMES;
 }
 // Deallocate memory when an exception occurs (ideally) or when the program terminates
 int exit_sim(){
     assert(simState == SIM_STATE_QUIT);
     deallocate_all_cells();
+    taskPool.stop();
+    decisionLog.close();
+    aiQuantizationReport.print();
     wait_for_user_to_exit_SDL();
     exit_SDL();
     return 0;
@@ -245,13 +380,161 @@ int exit_sim(){
 
 
 void assign_cells_to_correct_regions(){
-    // Clear pActivesRegions
-    for(int _x = 0; _x < cellRegionNumUbX; _x++){
-        for(int _y = 0; _y < cellRegionNumUbY; _y++){
-            pActivesRegions[{_x, _y}] = {};
+    pActivesRegions.resize(cellRegionNumUbX, cellRegionNumUbY);
+    pActivesRegions.clear();
+    for(auto pCell : pActives) pActivesRegions[pCell->xyRegion].push_back(pCell);
+    // Blocks of about one cell each (if the cells were spread evenly), so searches skip most of the empty regions
+    //  without going down through many levels where the cells are dense
+    int numCells = max_int(pActives.size(), 1), baseSideLen = 1;
+    while(baseSideLen < REGION_COUNTS_MAX_BASE_SIDE_LEN && (int64_t)4 * baseSideLen * baseSideLen * numCells <= (int64_t)cellRegionNumUbX * cellRegionNumUbY) baseSideLen *= 2;
+    pActivesRegionCounts.resize(cellRegionNumUbX, cellRegionNumUbY, baseSideLen);
+    pActivesRegionCounts.clear();
+    for(auto pCell : pActives) pActivesRegionCounts.add(pCell->xyRegion);
+}
+// Find every pair of cells which touch or repel each other. The attack, force, and energy phases
+//  all read this list instead of searching the neighboring regions themselves
+//  NOTE: Call this after assign_cells_to_correct_regions() whenever cells have moved or been created
+// Contacts can only change near a cell which moved, changed size, died, was born, or was removed since the
+//  list was last built. Every other cell is asleep: its contacts are copied from the last list instead of
+//  searched for again, so quiet areas (e.g. fields of plants and corpses) cost almost nothing
+void update_contact_list(){
+    // The per-region flags are only reset where they were set, so large, mostly empty maps cost nothing extra
+    static std::vector<char> isRegionChanged, isNearChange, isStillActive;
+    static std::vector<int> lastIndexInRegion, prevIndices, changedRegions, nearRegions;
+    ContactListHistory& history = contactListHistory;
+    int numCells = pActives.size(), numRegions = cellRegionNumUbX * cellRegionNumUbY;
+    auto region_index = [](std::pair<int,int> reg){ return reg.first * cellRegionNumUbY + reg.second; };
+    if(isRegionChanged.size() != numRegions){
+        isRegionChanged.assign(numRegions, false);
+        isNearChange.assign(numRegions, false);
+        lastIndexInRegion.assign(numRegions, -1);
+    }
+    changedRegions.clear();
+    auto mark_region_changed = [](int reg){
+        if(isRegionChanged[reg]) return;
+        isRegionChanged[reg] = true;
+        changedRegions.push_back(reg);
+    };
+    isStillActive.assign(history.pCells.size(), false);
+    prevIndices.resize(numCells);
+    for(int i = 0; i < numCells; i++){
+        Cell* pCell = pActives[i];
+        int reg = region_index(pCell->xyRegion);
+        int iPrev = history.find_cell(pCell);
+        prevIndices[i] = iPrev;
+        if(iPrev < 0 || history.regions[iPrev] >= numRegions){
+            mark_region_changed(reg);
+            continue;
         }
+        isStillActive[iPrev] = true;
+        if(history.regions[iPrev] != reg){ mark_region_changed(history.regions[iPrev]); mark_region_changed(reg); }
+        if(history.posXs[iPrev] != pCell->posX || history.posYs[iPrev] != pCell->posY) mark_region_changed(reg);
+        if(history.dias[iPrev] != pCell->get_dia() || history.isAlive[iPrev] != pCell->isAlive) mark_region_changed(reg);
+        // The cells of each region have to stay in the same order, or the copied contacts would be in a different order
+        if(iPrev < lastIndexInRegion[reg]) mark_region_changed(reg);
+        lastIndexInRegion[reg] = iPrev;
     }
-    for(auto pCell : pActives) pActivesRegions[pCell->xyRegion].push_back(pCell);
+    for(int iPrev = 0; iPrev < history.pCells.size(); iPrev++){
+        if(!isStillActive[iPrev] && history.regions[iPrev] < numRegions) mark_region_changed(history.regions[iPrev]);
+    }
+    // A cell only finds contacts in its own and the 8 neighboring regions (see get_neighboring_xyRegions())
+    nearRegions.clear();
+    for(int reg : changedRegions){
+        int x = reg / cellRegionNumUbY, y = reg % cellRegionNumUbY;
+        for(int dX = -1; dX <= 1; dX++){
+            for(int dY = -1; dY <= 1; dY++){
+                int _x = (x + dX + cellRegionNumUbX) % cellRegionNumUbX, _y = (y + dY + cellRegionNumUbY) % cellRegionNumUbY;
+                int nearReg = _x * cellRegionNumUbY + _y;
+                if(isNearChange[nearReg]) continue;
+                isNearChange[nearReg] = true;
+                nearRegions.push_back(nearReg);
+            }
+        }
+    }
+
+    std::swap(contactList, history.contactList);
+    contactList.clear(numCells);
+    for(int i = 0; i < numCells; i++) pActives[i]->iContacts = i;
+    WorldView world = get_world_view();
+    for(int i = 0; i < numCells; i++){
+        Cell* pCell = pActives[i];
+        pCell->isAsleep = (prevIndices[i] >= 0 && !isNearChange[region_index(pCell->xyRegion)]);
+        if(pCell->isAsleep) contactList.copy_contacts(history.contactList, prevIndices[i]);
+        else pCell->find_contacts(world, contactList);
+    }
+    for(int reg : changedRegions) isRegionChanged[reg] = false;
+    for(int reg : nearRegions) isNearChange[reg] = false;
+    for(auto pCell : pActives) lastIndexInRegion[region_index(pCell->xyRegion)] = -1;
+
+    history.pCells = pActives;
+    history.cellNums.resize(numCells); history.posXs.resize(numCells); history.posYs.resize(numCells);
+    history.dias.resize(numCells); history.regions.resize(numCells); history.isAlive.resize(numCells);
+    for(int i = 0; i < numCells; i++){
+        Cell* pCell = pActives[i];
+        history.cellNums[i] = pCell->uniqueCellNum;
+        history.posXs[i] = pCell->posX;
+        history.posYs[i] = pCell->posY;
+        history.dias[i] = pCell->get_dia();
+        history.regions[i] = region_index(pCell->xyRegion);
+        history.isAlive[i] = pCell->isAlive;
+    }
+}
+
+// Anchor the cells which were born or moved more than half of VISION_LIST_SKIN from their anchor,
+//  and log them as events, so the vision lists which may be missing them check them too (see VisionLists)
+//  NOTE: Call this after assign_cells_to_correct_regions(), right before the cells decide what to do
+void update_vision_lists(){
+    VisionLists& lists = visionLists;
+    for(int cellNum : lists.activeCellNums) lists.pCellsByNum[cellNum] = NULL;
+    lists.activeCellNums.clear();
+    int maxDia = 0;
+    for(auto pCell : pActives){
+        int cellNum = pCell->uniqueCellNum;
+        if(cellNum >= lists.pCellsByNum.size()) lists.pCellsByNum.resize(cellNum + 1, NULL);
+        lists.pCellsByNum[cellNum] = pCell;
+        lists.activeCellNums.push_back(cellNum);
+        maxDia = max_int(maxDia, pCell->get_dia());
+    }
+    // Every list is rebuilt in a new generation, so the cells are anchored without logging any events
+    bool isNewGeneration = maxDia > lists.maxDia || lists.movedCellNums.size() > pActives.size() + 64;
+    if(isNewGeneration){
+        lists.generation++;
+        lists.movedCellNums.clear();
+        lists.maxDia = maxDia;
+    }
+    int wrapUbX = WRAP_AROUND_X ? ubX.val : 0, wrapUbY = WRAP_AROUND_Y ? ubY.val : 0;
+    for(auto pCell : pActives){
+        if(pCell->visionAnchorGeneration == lists.generation){
+            int dX = wrap_offset(pCell->posX - pCell->visionAnchorX, wrapUbX);
+            int dY = wrap_offset(pCell->posY - pCell->visionAnchorY, wrapUbY);
+            if(4 * (dX*dX + dY*dY) <= VISION_LIST_SKIN * VISION_LIST_SKIN) continue;
+        }
+        pCell->visionAnchorGeneration = lists.generation;
+        pCell->visionAnchorX = pCell->posX;
+        pCell->visionAnchorY = pCell->posY;
+        if(!isNewGeneration) lists.movedCellNums.push_back(pCell->uniqueCellNum);
+    }
+}
+
+// Sort the cells into the lists of preyIndex by region and category, with their prey terms up to date
+//  NOTE: Call this after assign_cells_to_correct_regions(), right before the cells decide what to do
+void update_prey_index(){
+    preyIndex.resize(cellRegionNumUbX, cellRegionNumUbY);
+    preyIndex.clear();
+    for(auto pCell : pActives){
+        pCell->update_prey_terms();
+        int category = pCell->calc_prey_category();
+        PreyLists& lists = preyIndex[pCell->xyRegion];
+        if(lists.cells[category].empty() || pCell->preyRankBase > lists.maxRankBases[category]) lists.maxRankBases[category] = pCell->preyRankBase;
+        lists.cells[category].push_back(pCell);
+    }
+}
+// Once a cell decided, the cells which decide after it have to see where it is going now
+void update_prey_terms_in_index(Cell* pCell){
+    pCell->update_prey_terms();
+    int category = pCell->calc_prey_category();
+    PreyLists& lists = preyIndex[pCell->xyRegion];
+    lists.maxRankBases[category] = max_int(lists.maxRankBases[category], pCell->preyRankBase);
 }
 
 // Display the percentiles of certain cell stats
@@ -259,14 +542,10 @@ void assign_cells_to_correct_regions(){
 void disp_cell_statistics(std::map<std::string, int> statRestrictions, std::string label){
     std::map<std::string, float> avgStats;
     int numRelevantCells = 0;
+    // popCounts tells us in O(1) whether there is anything to scan for
+    if(statRestrictions.count("cellType") && popCounts.num_of_type(statRestrictions["cellType"]) == 0) return;
     for(auto pCell : pActives){
-        if(statRestrictions.count("cellType")){
-            if(statRestrictions["cellType"] == CELL_TYPE_PLANT && pCell->stats["EAM_SUN"][0] != 100) continue;
-            if(statRestrictions["cellType"] == CELL_TYPE_WORM  && pCell->stats["EAM_GND"][0] != 100) continue;
-            if(statRestrictions["cellType"] == CELL_TYPE_PREDATOR && pCell->stats["EAM_CELLS"][0] != 100) continue;
-            if(statRestrictions["cellType"] == CELL_TYPE_MUTANT && (pCell->stats["EAM_SUN"][0] < 30
-                || pCell->stats["EAM_GND"][0] < 30 || pCell->stats["EAM_CELLS"][0] < 30)) continue;
-        }
+        if(statRestrictions.count("cellType") && pCell->cellType != statRestrictions["cellType"]) continue;
         bool includeCell = true;
         for(auto stat : statRestrictions){
             std::string statName = stat.first;
@@ -296,87 +575,250 @@ void disp_cell_statistics(std::map<std::string, int> statRestrictions, std::stri
     cout << endl;
 }
 
-// Repeat this function each frame. Return the frame number
-int do_frame(bool doCellDecisions = true){
-    frameStart = SDL_GetTicks();
+// The cells each decide what to do (e.g. speed, direction, doAttack, etc.) by updating their internal state
+//  When replaying a decision log, the recorded decisions are used instead, so no vision queries or neural networks run
+// pActives[iUb], pActives[iUb-1], ..., pActives[iLb] decide what to do, in that order
+//  CELL_TYPE: The archetype all of them have (see Cell::get_kernel_type())
+template <int CELL_TYPE>
+void decide_cell_batch(int iLb, int iUb, const WorldView& world, bool usePreyIndex, bool doRecord){
+    for(int i = iUb; i >= iLb; i--){
+        Cell* pCell = pActives[i];
+        if(!doRecord){
+            pCell->decide_next_frame<CELL_TYPE>(world);
+            if(usePreyIndex) update_prey_terms_in_index(pCell);
+            continue;
+        }
+        CellDecision prevDecision = pCell->get_decision();
+        int prevEnergy = pCell->energy, prevHealth = pCell->health;
+        pCell->decide_next_frame<CELL_TYPE>(world);
+        if(usePreyIndex) update_prey_terms_in_index(pCell);
+        CellDecision decision = pCell->get_decision();
+        decision.clampedState = (pCell->energy != prevEnergy || pCell->health != prevHealth);
+        decisionLog.write_decision(prevDecision, decision);
+    }
+}
 
-    //cout << "Frame start\n";
+void decide_cell_actions(const WorldView& world, bool doCellDecisions){
+    int numDecisions = doCellDecisions ? pActives.size() : 0;
+    if(decisionLog.is_replaying() && decisionLog.begin_replay_frame(numDecisions)){
+        CellDecision decision;
+        for(; numDecisions > 0; numDecisions--){
+            Cell* pCell = pActives[numDecisions-1];
+            if(!decisionLog.read_decision(pCell->get_decision(), decision)) break;
+            pCell->replay_decision(decision);
+        }
+        if(numDecisions == 0){
+            decisionLog.end_replay_frame();
+            return;
+        }
+        // The log ended in the middle of the frame, so the cells which are left decide for themselves
+    }
+    // The cells don't move while they decide, so their vision queries can use the cached lists
+    WorldView visionWorld = world;
+    // Only the RNG-based AI chases other cells
+    bool usePreyIndex = numDecisions > 0 && aiMode == RNG_BASED_AI_MODE;
+    if(numDecisions > 0){
+        update_vision_lists();
+        visionWorld.pVisionLists = &visionLists;
+    }
+    if(usePreyIndex){
+        update_prey_index();
+        visionWorld.pPreyIndex = &preyIndex;
+    }
+    bool doRecord = decisionLog.is_recording();
+    if(doRecord) decisionLog.begin_record_frame(numDecisions);
+    // Each run of consecutive cells of the same archetype is decided as one batch
+    //  NOTE: The batches are NOT reordered, since each cell draws from rand() and sees the decisions of the cells before it
+    for(int iUb = numDecisions-1; iUb >= 0;){
+        int cellType = pActives[iUb]->get_kernel_type();
+        int iLb = iUb;
+        while(iLb > 0 && pActives[iLb-1]->get_kernel_type() == cellType) iLb--;
+        switch(cellType){
+            case CELL_TYPE_PLANT:
+            decide_cell_batch<CELL_TYPE_PLANT>(iLb, iUb, visionWorld, usePreyIndex, doRecord);
+            break;
+            case CELL_TYPE_WORM:
+            decide_cell_batch<CELL_TYPE_WORM>(iLb, iUb, visionWorld, usePreyIndex, doRecord);
+            break;
+            case CELL_TYPE_PREDATOR:
+            decide_cell_batch<CELL_TYPE_PREDATOR>(iLb, iUb, visionWorld, usePreyIndex, doRecord);
+            break;
+            default:
+            decide_cell_batch<CELL_TYPE_GENERIC>(iLb, iUb, visionWorld, usePreyIndex, doRecord);
+            break;
+        }
+        iUb = iLb-1;
+    }
+    if(doRecord) decisionLog.end_record_frame();
+}
 
-    assign_cells_to_correct_regions();
-    if(doCellDecisions && doCellAi){
-        // The cells each decide what to do (e.g. speed, direction, doAttack, etc.) by updating their internal state
-        for(int i = pActives.size()-1; i >= 0; i--) pActives[i]->decide_next_frame(pActivesRegions, pCellsHist);
+// Move every cell into one new block of cellPool in Z-order (Morton order) of their positions, so the cells
+//  which interact with each other are mostly next to each other in memory. pActives keeps its order, and
+//  every pointer to a cell which is kept between frames is updated (the regions are rebuilt by the caller)
+//  NOTE: The cells are moved, so no other pointer to a cell may be held across this function
+void sort_cell_storage(){
+    int numCells = pActives.size();
+    // A cell outside pActives (e.g. one made by a test) would keep pointing into the freed blocks
+    if(numCells == 0 || cellPool.numLive != numCells) return;
+    static std::vector<std::pair<uint32_t, int>> keys;
+    keys.resize(numCells);
+    for(int i = 0; i < numCells; i++){
+        // Positions are already within the map (i.e. wrapped around the torus)
+        keys[i] = {calc_morton_code(pActives[i]->posX, pActives[i]->posY), i};
+    }
+    radix_sort_by_key(keys);
+    // Room for the births until the next sort
+    cellPool.begin_move(numCells + numCells / 4 + 64);
+    static std::vector<std::pair<Cell*, Cell*>> moved; // {old pointer, new pointer}
+    moved.resize(numCells);
+    for(int i = 0; i < numCells; i++){
+        Cell* pOld = pActives[keys[i].second];
+        Cell* pNew = ::new (cellPool.alloc()) Cell(std::move(*pOld));
+        pNew->pSelf = pNew;
+        moved[i] = {pOld, pNew};
     }
+    std::sort(moved.begin(), moved.end());
+    // Removed cells may still be in the contact list history (see ContactListHistory::find_cell(...)), so
+    //  pointers which were not moved are cleared instead of followed
+    auto find_moved = [](Cell* pOld){
+        auto it = std::lower_bound(moved.begin(), moved.end(), std::pair<Cell*, Cell*>(pOld, NULL));
+        return (it != moved.end() && it->first == pOld) ? it->second : NULL;
+    };
+    for(auto& pCell : pActives) pCell = find_moved(pCell);
+    for(auto& contact : contactList.contacts) contact.pOther = find_moved(contact.pOther);
+    for(auto& contact : contactListHistory.contactList.contacts) contact.pOther = find_moved(contact.pOther);
+    for(auto& pCell : contactListHistory.pCells) pCell = find_moved(pCell);
+    for(auto& item : moved) item.first->~Cell();
+    cellPool.end_move(numCells);
+}
 
-    //cout << "a";
+// The phases of a frame (see step_sim()). Most of them read and write the cells, so each waits for the one before it
+//  The day-night cycle only has to be done before the cells take in energy, and the ground only regenerates after
+//  they took energy from it, so those two overlap with the phases around them
+//  iCellsDone: The last phase which changes the cells. iGndDone: The phase which regenerates the ground
+void build_frame_graph(TaskGraph& graph, bool doCellDecisions, int& iCellsDone, int& iGndDone){
+    graph.clear();
+    WorldView world = get_world_view();
 
+    int iDecide = graph.add("decide", [=]{
+        if(frameNum % CELL_STORAGE_SORT_PERIOD == 0) sort_cell_storage();
+        assign_cells_to_correct_regions();
+        decide_cell_actions(world, doCellDecisions && doCellAi);
+    });
 
     // Cells move to their target positions based on their speed
-    for(int i = pActives.size()-1; i >= 0; i--) pActives[i]->update_target_pos();
-    assign_cells_to_correct_regions();
-
-    //cout << "b";
+    int iMove = graph.add("move", [=]{
+        update_target_positions();
+        assign_cells_to_correct_regions();
+    }, {iDecide});
 
     // Cells apply all their non-movement decisions this frame
     //  such as attacking and cloning. Deaths are dealt with after
-    if(doCellAi){
-        // Bug fix: using for(auto pCell : pActives) is a bad idea when pActives changes size during the algorithm
-        for(int i = pActives.size()-1; i >= 0; i--) {
-            pActives[i]->apply_non_movement_decisions(pActives, pCellsHist, pActivesRegions);
+    int iInteract = graph.add("interact", [=]{
+        if(!doCellAi){
+            update_contact_list();
+            return;
+        }
+        // Clones are only buffered here, so pActives does NOT change size during this loop.
+        //  Each parent's orderKey is its position in this loop, which fixes the commit order
+        update_contact_list();
+        int numActives = pActives.size();
+        for(int i = numActives-1; i >= 0; i--) {
+            pActives[i]->apply_non_movement_decisions(spawnBuffers[0], numActives-1-i, count_pending_spawns(), world);
         }
+        int numBirths = count_pending_spawns();
+        commit_spawn_buffers();
         assign_cells_to_correct_regions();
-    }
-
-    //cout << "c";
+        // Attacks don't move anything, so the contacts only change if there were births
+        if(numBirths > 0) update_contact_list();
+    }, {iMove});
 
     // Cells move to new positions if enough force is applied
-    for(int i = pActives.size()-1; i >= 0; i--) pActives[i]->update_forces(pActivesRegions);
-    for(int i = pActives.size()-1; i >= 0; i--) pActives[i]->apply_forces();
-    assign_cells_to_correct_regions();
-
-    do_day_night_cycle();
-    update_dayNightCycleTime();
-
-    
-    if(automateEnergy){
-        for(int i = pActives.size()-1; i >= 0; i--) pActives[i]->do_energy_transfer(pActivesRegions);
-        for(int i = pActives.size()-1; i >= 0; i--) pActives[i]->do_energy_decay(pActivesRegions);
+    //  Sleeping cells which touch nothing have no forces to apply
+    int iForces = graph.add("forces", [=]{
+        for(int i = pActives.size()-1; i >= 0; i--){
+            Cell* pCell = pActives[i];
+            if(pCell->isAsleep && world.get_contacts(pCell->iContacts).empty() && pCell->forceX == 0 && pCell->forceY == 0) continue;
+            pCell->update_forces(world);
+            pCell->apply_forces();
+        }
+        assign_cells_to_correct_regions();
+    }, {iInteract});
+
+    // Only do_energy_transfer(...) reads the energy from the sun
+    int iDayNight = graph.add("dayNight", []{
+        do_day_night_cycle();
+        update_dayNightCycleTime();
+    }, {}, false);
+
+    int iEnergy = graph.add("energy", [=]{
+        if(!automateEnergy) return;
+        update_contact_list(); // The forces moved the cells
+        for(int i = pActives.size()-1; i >= 0; i--) pActives[i]->do_energy_transfer(world);
+        for(int i = pActives.size()-1; i >= 0; i--) pActives[i]->do_energy_decay(world);
         for(int i = pActives.size()-1; i >= 0; i--) pActives[i]->consume_energy_per_frame();
-    }
-
+    }, {iForces, iDayNight});
 
-    // Kill all cells which meet at least one of the conditions for dying
-    for(int i = pActives.size() - 1; i >= 0; i--) {
-        if(pActives[i]->isAlive == false) continue;
-        if(pActives[i]->calc_if_cell_is_dead()) pActives[i]->kill_self();
-    }
+    int iDeaths = graph.add("deaths", []{
+        // Kill all cells which meet at least one of the conditions for dying
+        for(int i = pActives.size() - 1; i >= 0; i--) {
+            if(pActives[i]->isAlive == false) continue;
+            if(pActives[i]->calc_if_cell_is_dead()) pActives[i]->kill_self();
+        }
+        // Deal with dead cells
+        //  Removed cells are freed right away, since only lineageLog needs to remember them
+        for(int i = pActives.size() - 1; i >= 0; i--) {
+            Cell* pCell = pActives[i];
+            if(pCell->remove_this_dead_cell_if_depleted(pActives, i)) delete pCell;
+        }
+    }, {iEnergy});
 
-    // Deal with dead cells
-    for(int i = pActives.size() - 1; i >= 0; i--) pActives[i]->remove_this_dead_cell_if_depleted(pActives, i);
+    // Every certain number of frames, the energy levels within the ground should be increased for all ground pixels
+    //  Dying and being removed never touches the ground
+    iGndDone = graph.add("gnd", []{
+        if(automateEnergy && frameNum % FRAMES_BETWEEN_GND_ENERGY_ACCUMULATION == 0){
+            increase_sim_gnd_energy(gndEnergyPerIncrease.val);
+        }
+    }, {iEnergy}, false);
 
-    //cout << "d";
+    iCellsDone = iDeaths;
+    graph.add("regroup", []{
+        assign_cells_to_correct_regions();
+        if(frameNum == 0 || (frameNum <= 2000 && frameNum % 50 == 0) || (frameNum <= 10000 && frameNum % 200 == 0) || frameNum % 500 == 0){
+            cout << endl;
+            disp_cell_statistics({{"cellType", CELL_TYPE_PLANT}},       "Plant Statistics"      );
+            disp_cell_statistics({{"cellType", CELL_TYPE_WORM}},        "Worm Statistics"       );
+            disp_cell_statistics({{"cellType", CELL_TYPE_PREDATOR}},    "Predator Statistics"   );
+            disp_cell_statistics({{"cellType", CELL_TYPE_MUTANT}},      "Mutant Statistics"     );
+        }
+    }, {iDeaths});
+}
+TaskGraph frameGraph;
+
+// Everything in a frame except rendering and user interactions, i.e. the part that
+//  can run on its own thread (see renderThread.h). This does NOT increment frameNum
+void step_sim(bool doCellDecisions = true){
+    int iCellsDone, iGndDone;
+    build_frame_graph(frameGraph, doCellDecisions, iCellsDone, iGndDone);
+    frameGraph.run();
+}
 
-    // Every certain number of frames, the energy levels within the ground should be increased for all ground pixels
-    if(automateEnergy && frameNum % FRAMES_BETWEEN_GND_ENERGY_ACCUMULATION == 0){
-        increase_sim_gnd_energy(gndEnergyPerIncrease.val);
-    }
+// Repeat this function each frame. Return the frame number
+int do_frame(bool doCellDecisions = true){
+    frameStart = SDL_GetTicks();
+    step_sim(doCellDecisions);
 
     // Rendering and User Interactions
-    assign_cells_to_correct_regions();
     #ifdef DO_VIDEO
     do_video1();
     #else
     SDL_draw_frame();
     #endif
-    //cout << "\nFrame end\n";
-    if(frameNum == 0 || (frameNum <= 2000 && frameNum % 50 == 0) || (frameNum <= 10000 && frameNum % 200 == 0) || frameNum % 500 == 0){
-        cout << endl;
-        disp_cell_statistics({{"cellType", CELL_TYPE_PLANT}},       "Plant Statistics"      );
-        disp_cell_statistics({{"cellType", CELL_TYPE_WORM}},        "Worm Statistics"       );
-        disp_cell_statistics({{"cellType", CELL_TYPE_PREDATOR}},    "Predator Statistics"   );
-        disp_cell_statistics({{"cellType", CELL_TYPE_MUTANT}},      "Mutant Statistics"     );
-    }
+    #ifdef DO_OFFSCREEN_VIDEO
+    export_video_frame(); // Nobody can press keys, so the frames just keep coming
+    #else
     SDL_event_handler(pActives.size());
+    #endif
     return ++frameNum;
 }
 
@@ -399,6 +841,13 @@ void do_sim_iteration(bool doCellDecisions = true){
         restart_sim();
         break;
         default:
+        #ifndef DO_VIDEO
+        if(DECOUPLE_RENDERING){
+            // Returns once the user quits or restarts the simulation
+            run_decoupled_sim();
+            break;
+        }
+        #endif
         frameNum = do_frame(doCellDecisions);
     }
 }
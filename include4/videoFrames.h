@@ -62,8 +62,8 @@ void gen_demo_cells_video1(int scenarioNum){
             &dayNightExponentPct, &dayNightUbPct},
             {7, 5, DAY_NIGHT_DEFAULT_MODE, 120, 0, 1, 200, 150, 50});
         varVals.clear(); varVals = gen_std_stats("plant", 2, 2, 2, 500, 3000, 500);
-        pCellsHist[0]->set_int_stats(varVals, 0);
-        pCellsHist[0]->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->set_int_stats(varVals, 0);
+        get_cell_by_id(0)->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
         scenario_postcode();
         break;
 
@@ -73,8 +73,8 @@ void gen_demo_cells_video1(int scenarioNum){
         set_sim_params({&ubX, &ubY, &dayNightMode, &maxSunEnergyPerSec, &gndEnergyPerIncrease, &maxGndEnergy},
             {15, 10, DAY_NIGHT_ALWAYS_DAY_MODE, 0, 20, 200});
         varVals.clear(); varVals = gen_std_stats("worm", 3, 4, 5, 200, 2000);
-        pCellsHist[0]->set_int_stats(varVals, 0);
-        pCellsHist[0]->force_decision(1000, 0, 0, WALK_MODE, false, false, false);
+        get_cell_by_id(0)->set_int_stats(varVals, 0);
+        get_cell_by_id(0)->force_decision(1000, 0, 0, WALK_MODE, false, false, false);
         scenario_postcode();
         break;
 
@@ -84,22 +84,22 @@ void gen_demo_cells_video1(int scenarioNum){
         set_sim_params({&ubX, &ubY, &dayNightMode, &maxSunEnergyPerSec, &gndEnergyPerIncrease, &maxGndEnergy},
             {15, 10, DAY_NIGHT_ALWAYS_DAY_MODE, 50, 10, 100});
         varVals.clear(); varVals = gen_std_stats("plant", 3, 2, 3, 3000, 15000);
-        pCellsHist[0]->set_int_stats(varVals, 0);
-        pCellsHist[0]->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->set_int_stats(varVals, 0);
+        get_cell_by_id(0)->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
         varVals.clear(); varVals = gen_std_stats("worm", 7, 6, 2, 2000, 10000);
-        pCellsHist[1]->set_int_stats(varVals, 0);
-        pCellsHist[1]->force_decision(1000, 0, 0, WALK_MODE, false, false, false);
+        get_cell_by_id(1)->set_int_stats(varVals, 0);
+        get_cell_by_id(1)->force_decision(1000, 0, 0, WALK_MODE, false, false, false);
         varVals.clear(); varVals = gen_std_stats("predator", 3, 8, 2, 1000, 10000);
-        pCellsHist[2]->set_int_stats(varVals);
-        pCellsHist[2]->force_decision(10, 0, 0, WALK_MODE, true, false, false);     // (12,7)|(1,5)
-        pCellsHist[2]->force_decision(2, 315, 0, RUN_MODE, true, false, false);     // (14,5)|(3,5)
-        pCellsHist[2]->force_decision(3, 0, 0, RUN_MODE, true, false, false);       // (5,7)|(6,5)
-        pCellsHist[2]->force_decision(6, 0, 0, IDLE_MODE, true, false, false);      // (5,7)
-        pCellsHist[2]->force_decision(3, 0, 0, WALK_MODE, true, false, false);      // (8,7)
-        pCellsHist[2]->force_decision(4, 270, 0, WALK_MODE, true, false, false);    // (8,3)
-        pCellsHist[2]->force_decision(5, 180, 0, WALK_MODE, true, false, false);    // (3,3)
-        pCellsHist[2]->force_decision(8, 0, 0, IDLE_MODE, true, false, false);      // (3,3)
-        pCellsHist[2]->force_decision(1000, 0, 0, WALK_MODE, true, false, false);
+        get_cell_by_id(2)->set_int_stats(varVals);
+        get_cell_by_id(2)->force_decision(10, 0, 0, WALK_MODE, true, false, false);     // (12,7)|(1,5)
+        get_cell_by_id(2)->force_decision(2, 315, 0, RUN_MODE, true, false, false);     // (14,5)|(3,5)
+        get_cell_by_id(2)->force_decision(3, 0, 0, RUN_MODE, true, false, false);       // (5,7)|(6,5)
+        get_cell_by_id(2)->force_decision(6, 0, 0, IDLE_MODE, true, false, false);      // (5,7)
+        get_cell_by_id(2)->force_decision(3, 0, 0, WALK_MODE, true, false, false);      // (8,7)
+        get_cell_by_id(2)->force_decision(4, 270, 0, WALK_MODE, true, false, false);    // (8,3)
+        get_cell_by_id(2)->force_decision(5, 180, 0, WALK_MODE, true, false, false);    // (3,3)
+        get_cell_by_id(2)->force_decision(8, 0, 0, IDLE_MODE, true, false, false);      // (3,3)
+        get_cell_by_id(2)->force_decision(1000, 0, 0, WALK_MODE, true, false, false);
         scenario_postcode();
         break;
 
@@ -109,17 +109,17 @@ void gen_demo_cells_video1(int scenarioNum){
         set_sim_params({&ubX, &ubY, &dayNightMode, &maxSunEnergyPerSec, &gndEnergyPerIncrease, &maxGndEnergy},
             {30, 20, DAY_NIGHT_ALWAYS_DAY_MODE, 50, 40, 200});
         varVals.clear(); varVals = gen_std_stats("plant", 6, 7, 2, 1500, 4000);
-        pCellsHist[0]->set_int_stats(varVals);
-        pCellsHist[0]->force_decision(1000, 0, 0, IDLE_MODE, false, false, true);
+        get_cell_by_id(0)->set_int_stats(varVals);
+        get_cell_by_id(0)->force_decision(1000, 0, 0, IDLE_MODE, false, false, true);
         varVals.clear(); varVals = gen_std_stats("worm", 22, 11, 2, 1000, 4000);
-        pCellsHist[1]->set_int_stats(varVals);
-        pCellsHist[1]->force_decision(1000, 0, 70, WALK_MODE, false, false, true);
+        get_cell_by_id(1)->set_int_stats(varVals);
+        get_cell_by_id(1)->force_decision(1000, 0, 70, WALK_MODE, false, false, true);
         varVals.clear(); varVals = gen_std_stats("predator", 16, 18, 2, 1000, 4000);
-        pCellsHist[2]->set_int_stats(varVals);
-        pCellsHist[2]->force_decision(15, 0, 270, WALK_MODE, true, false, true);
-        pCellsHist[2]->force_decision(6, 315, 270, RUN_MODE, true, false, true);
-        pCellsHist[2]->force_decision(6, 0, 270, RUN_MODE, true, false, true);
-        pCellsHist[2]->force_decision(100, 0, 270, IDLE_MODE, true, false, true);
+        get_cell_by_id(2)->set_int_stats(varVals);
+        get_cell_by_id(2)->force_decision(15, 0, 270, WALK_MODE, true, false, true);
+        get_cell_by_id(2)->force_decision(6, 315, 270, RUN_MODE, true, false, true);
+        get_cell_by_id(2)->force_decision(6, 0, 270, RUN_MODE, true, false, true);
+        get_cell_by_id(2)->force_decision(100, 0, 270, IDLE_MODE, true, false, true);
         scenario_postcode();
         break;
 
@@ -129,20 +129,20 @@ void gen_demo_cells_video1(int scenarioNum){
         set_sim_params({&ubX, &ubY, &dayNightMode, &maxSunEnergyPerSec, &gndEnergyPerIncrease, &maxGndEnergy},
             {7, 3, DAY_NIGHT_ALWAYS_DAY_MODE, 0, 0, 1000});
         varVals.clear(); varVals = gen_std_stats("worm", 0, 1, 1, 500, 3000);
-        pCellsHist[0]->set_int_stats(varVals, 0);
-        pCellsHist[0]->force_decision(20, 0, 0, IDLE_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1, 0, 0, WALK_MODE, false, false, false);
-        pCellsHist[0]->force_decision(20, 0, 0, IDLE_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1, 0, 0, WALK_MODE, false, false, false);
-        pCellsHist[0]->force_decision(10, 0, 0, IDLE_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1, 0, 0, WALK_MODE, false, false, false);
-        pCellsHist[0]->force_decision(5, 0, 0, IDLE_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1, 180, 0, WALK_MODE, false, false, false);
-        pCellsHist[0]->force_decision(20, 0, 0, IDLE_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1, 0, 0, WALK_MODE, false, false, false);
-        pCellsHist[0]->force_decision(50, 0, 0, IDLE_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1, 180, 0, WALK_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->set_int_stats(varVals, 0);
+        get_cell_by_id(0)->force_decision(20, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1, 0, 0, WALK_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(20, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1, 0, 0, WALK_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(10, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1, 0, 0, WALK_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(5, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1, 180, 0, WALK_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(20, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1, 0, 0, WALK_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(50, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1, 180, 0, WALK_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
         scenario_postcode();
         break;
         
@@ -152,18 +152,18 @@ void gen_demo_cells_video1(int scenarioNum){
         set_sim_params({&ubX, &ubY, &dayNightMode, &maxSunEnergyPerSec, &gndEnergyPerIncrease, &maxGndEnergy},
             {7, 3, DAY_NIGHT_ALWAYS_DAY_MODE, 0, 0, 1000});
         varVals.clear(); varVals = gen_std_stats("worm", 1, 1, 2, 600, 3000);
-        pCellsHist[0]->set_int_stats(varVals, 0);
-        pCellsHist[0]->force_decision(30, 0, 0, IDLE_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1, 0, 0, WALK_MODE, false, false, false);
-        pCellsHist[0]->force_decision(20, 0, 0, IDLE_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1, 0, 0, RUN_MODE, false, false, false);
-        pCellsHist[0]->force_decision(5, 0, 0, IDLE_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1, 180, 0, RUN_MODE, false, false, false);
-        pCellsHist[0]->force_decision(20, 0, 0, IDLE_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1, 0, 0, RUN_MODE, false, false, false);
-        pCellsHist[0]->force_decision(60, 0, 0, IDLE_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1, 180, 0, RUN_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->set_int_stats(varVals, 0);
+        get_cell_by_id(0)->force_decision(30, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1, 0, 0, WALK_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(20, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1, 0, 0, RUN_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(5, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1, 180, 0, RUN_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(20, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1, 0, 0, RUN_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(60, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1, 180, 0, RUN_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
         scenario_postcode();
         break;
 
@@ -173,18 +173,18 @@ void gen_demo_cells_video1(int scenarioNum){
         set_sim_params({&ubX, &ubY, &dayNightMode, &maxSunEnergyPerSec, &gndEnergyPerIncrease, &maxGndEnergy},
             {7, 3, DAY_NIGHT_ALWAYS_DAY_MODE, 0, 0, 1000});
         varVals.clear(); varVals = gen_std_stats("worm", 1, 1, 2, 600, 3000);
-        pCellsHist[0]->set_int_stats(varVals, 0);
-        pCellsHist[0]->force_decision(30, 0, 0, IDLE_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1, 0, 0, WALK_MODE, false, false, false);
-        pCellsHist[0]->force_decision(20, 0, 0, IDLE_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1, 0, 0, RUN_MODE, false, false, false);
-        pCellsHist[0]->force_decision(5, 0, 0, IDLE_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1, 180, 0, RUN_MODE, false, false, false);
-        pCellsHist[0]->force_decision(20, 0, 0, IDLE_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1, 0, 0, RUN_MODE, false, false, false);
-        pCellsHist[0]->force_decision(60, 0, 0, IDLE_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1, 180, 0, RUN_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->set_int_stats(varVals, 0);
+        get_cell_by_id(0)->force_decision(30, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1, 0, 0, WALK_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(20, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1, 0, 0, RUN_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(5, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1, 180, 0, RUN_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(20, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1, 0, 0, RUN_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(60, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1, 180, 0, RUN_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
         scenario_postcode();
         break;
 
@@ -201,11 +201,11 @@ void gen_demo_cells_video1(int scenarioNum){
         set_sim_params({&ubX, &ubY, &dayNightMode, &maxSunEnergyPerSec, &gndEnergyPerIncrease, &maxGndEnergy},
             {6, 4, DAY_NIGHT_ALWAYS_DAY_MODE, 50, 0, 1});
         varVals.clear(); varVals = gen_std_stats("plant", 1, 1, 2, 1000, 10000, 10);
-        pCellsHist[0]->set_int_stats(varVals);
-        pCellsHist[0]->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->set_int_stats(varVals);
+        get_cell_by_id(0)->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
         varVals.clear(); varVals = gen_std_stats("plant", 4, 1, 2, 1, 100000);
-        pCellsHist[1]->set_int_stats(varVals);
-        pCellsHist[1]->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(1)->set_int_stats(varVals);
+        get_cell_by_id(1)->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
         scenario_postcode();
         break;
 
@@ -216,29 +216,29 @@ void gen_demo_cells_video1(int scenarioNum){
             {30, 20, DAY_NIGHT_ALWAYS_DAY_MODE, 50, 40, 200});
         varVals.clear(); varVals = gen_std_stats("plant", 21, 13, 7, 11000, 20000, 10);
         //varVals["maxHealth"] = 10; varVals["health"] = varVals["maxHealth"];
-        pCellsHist[0]->set_int_stats(varVals);
-        pCellsHist[0]->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->set_int_stats(varVals);
+        get_cell_by_id(0)->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
         varVals.clear(); varVals = gen_std_stats("predator", 6, 2, 2, 1000, 5000, 1, 100,
         1, 0, 0, 0, 0, 1, 3, 0);
-        pCellsHist[1]->set_int_stats(varVals);
-        pCellsHist[1]->force_decision(5, 330, 0, RUN_MODE, true, false, false);
-        pCellsHist[1]->force_decision(3, 0, 0, WALK_MODE, true, false, false);
-        pCellsHist[1]->force_decision(2, 270, 0, WALK_MODE, true, false, false);
-        pCellsHist[1]->force_decision(1000, 0, 0, IDLE_MODE, true, false, false);
+        get_cell_by_id(1)->set_int_stats(varVals);
+        get_cell_by_id(1)->force_decision(5, 330, 0, RUN_MODE, true, false, false);
+        get_cell_by_id(1)->force_decision(3, 0, 0, WALK_MODE, true, false, false);
+        get_cell_by_id(1)->force_decision(2, 270, 0, WALK_MODE, true, false, false);
+        get_cell_by_id(1)->force_decision(1000, 0, 0, IDLE_MODE, true, false, false);
         varVals["posX"] = 21; varVals["posY"] = 8; varVals["speedRun"] = 3;
-        pCellsHist[2]->set_int_stats(varVals);
-        pCellsHist[2]->force_decision(10, 330, 0, RUN_MODE, true, false, false);
-        pCellsHist[2]->force_decision(3, 270, 0, WALK_MODE, true, false, false);
-        pCellsHist[2]->force_decision(13, 180, 0, WALK_MODE, true, false, false);
-        pCellsHist[2]->force_decision(2, 270, 0, WALK_MODE, true, false, false);
-        pCellsHist[2]->force_decision(6, 180, 0, WALK_MODE, true, false, false);
-        pCellsHist[2]->force_decision(1000, 0, 0, IDLE_MODE, true, false, false);
+        get_cell_by_id(2)->set_int_stats(varVals);
+        get_cell_by_id(2)->force_decision(10, 330, 0, RUN_MODE, true, false, false);
+        get_cell_by_id(2)->force_decision(3, 270, 0, WALK_MODE, true, false, false);
+        get_cell_by_id(2)->force_decision(13, 180, 0, WALK_MODE, true, false, false);
+        get_cell_by_id(2)->force_decision(2, 270, 0, WALK_MODE, true, false, false);
+        get_cell_by_id(2)->force_decision(6, 180, 0, WALK_MODE, true, false, false);
+        get_cell_by_id(2)->force_decision(1000, 0, 0, IDLE_MODE, true, false, false);
         varVals["posX"] = 1; varVals["posY"] = 1; varVals["speedRun"] = 2;
-        pCellsHist[3]->set_int_stats(varVals);
-        pCellsHist[3]->force_decision(4, 45, 0, RUN_MODE, true, false, false);
-        pCellsHist[3]->force_decision(17, 0, 0, WALK_MODE, true, false, false);
-        pCellsHist[3]->force_decision(5, 90, 0, WALK_MODE, true, false, false);
-        pCellsHist[3]->force_decision(100, 0, 0, IDLE_MODE, true, false, false);
+        get_cell_by_id(3)->set_int_stats(varVals);
+        get_cell_by_id(3)->force_decision(4, 45, 0, RUN_MODE, true, false, false);
+        get_cell_by_id(3)->force_decision(17, 0, 0, WALK_MODE, true, false, false);
+        get_cell_by_id(3)->force_decision(5, 90, 0, WALK_MODE, true, false, false);
+        get_cell_by_id(3)->force_decision(100, 0, 0, IDLE_MODE, true, false, false);
         scenario_postcode();
         break;
 
@@ -249,8 +249,8 @@ void gen_demo_cells_video1(int scenarioNum){
         set_sim_params({&ubX, &ubY, &dayNightMode, &maxSunEnergyPerSec, &gndEnergyPerIncrease, &maxGndEnergy},
             {30, 20, DAY_NIGHT_ALWAYS_DAY_MODE, 0, 40, 200});
         varVals.clear(); varVals = gen_std_stats("worm", 14, 9, 8, 500, 5000);
-        pCellsHist[0]->set_int_stats(varVals, 0);
-        pCellsHist[0]->force_decision(1000, 0, 0, WALK_MODE, false, false, false);
+        get_cell_by_id(0)->set_int_stats(varVals, 0);
+        get_cell_by_id(0)->force_decision(1000, 0, 0, WALK_MODE, false, false, false);
         scenario_postcode();
         break;
 
@@ -262,13 +262,13 @@ void gen_demo_cells_video1(int scenarioNum){
             {30, 20, DAY_NIGHT_ALWAYS_DAY_MODE, 0, 0, 1});
         #define init_small_predator(varVals, cellNum, dx, dy, attackCooldown, speedDir){ \
             varVals.clear(); varVals = gen_std_stats("predator", 10 + dx, 10 + dy, 2, 1000, 10000, 1, 100, 1, attackCooldown); \
-            pCellsHist[cellNum]->set_int_stats(varVals, 0); \
-            pCellsHist[cellNum]->force_decision(6, speedDir, 0, WALK_MODE, true, false, false); \
-            pCellsHist[cellNum]->force_decision(100, speedDir, 0, IDLE_MODE, true, false, false); \
+            get_cell_by_id(cellNum)->set_int_stats(varVals, 0); \
+            get_cell_by_id(cellNum)->force_decision(6, speedDir, 0, WALK_MODE, true, false, false); \
+            get_cell_by_id(cellNum)->force_decision(100, speedDir, 0, IDLE_MODE, true, false, false); \
         }
         varVals.clear(); varVals = gen_std_stats("predator", 10, 10, 6, 4000, 30000, 7);
-        pCellsHist[0]->set_int_stats(varVals, 0);
-        pCellsHist[0]->force_decision(100, 0, 0, IDLE_MODE, true, false, false);
+        get_cell_by_id(0)->set_int_stats(varVals, 0);
+        get_cell_by_id(0)->force_decision(100, 0, 0, IDLE_MODE, true, false, false);
         init_small_predator(varVals, 1, -9,  0, 2, 0  );
         init_small_predator(varVals, 2,  0, -9, 2, 90 );
         init_small_predator(varVals, 3,  9,  0, 2, 180);
@@ -287,9 +287,9 @@ void gen_demo_cells_video1(int scenarioNum){
             {16, 16, DAY_NIGHT_ALWAYS_DAY_MODE, 50, 0, 1});
         #define init_plant(cellNum, varVals, dx, dy, dia, cloningDir, initEnergy) { \
             varVals.clear(); varVals = gen_std_stats("plant", 8 + dx, 8 + dy, dia, initEnergy, 2*initEnergy, 200); \
-            pCellsHist[cellNum]->set_int_stats(varVals, 0); \
-            pCellsHist[cellNum]->force_decision(50, 0, cloningDir, IDLE_MODE, false, false, (cellNum != 0)); \
-            pCellsHist[cellNum]->force_decision(1000, 0, cloningDir, IDLE_MODE, false, false, false); \
+            get_cell_by_id(cellNum)->set_int_stats(varVals, 0); \
+            get_cell_by_id(cellNum)->force_decision(50, 0, cloningDir, IDLE_MODE, false, false, (cellNum != 0)); \
+            get_cell_by_id(cellNum)->force_decision(1000, 0, cloningDir, IDLE_MODE, false, false, false); \
         }
         init_plant(0, varVals,  0,  0, 6, 0  , 2500);
         init_plant(1, varVals, -5,  0, 2, 0  , 2500);
@@ -314,12 +314,12 @@ void gen_demo_cells_video1(int scenarioNum){
         //  (output a speed mode and direction at random)
         #define init_worm(cellNum, varVals, posX, posY, dia){ \
             varVals.clear(); varVals = gen_std_stats("worm", posX, posY, dia, 1500, 5000*dia); \
-            pCellsHist[cellNum]->set_int_stats(varVals, 0); \
+            get_cell_by_id(cellNum)->set_int_stats(varVals, 0); \
         }
-        //pCellsHist[cellNum]->force_decision(45, 0, 90, WALK_MODE, false, false, true);
-        for(tmpVar = 0; tmpVar < pCellsHist.size(); tmpVar++){
+        //get_cell_by_id(cellNum)->force_decision(45, 0, 90, WALK_MODE, false, false, true);
+        for(tmpVar = 0; tmpVar < lineageLog.num_records(); tmpVar++){
             init_worm(tmpVar, varVals, 13*(tmpVar^2+tmpVar+100) % ubX.val, 17*(tmpVar^2+tmpVar+50) % ubY.val, 2);
-            if(++tmpVar >= pCellsHist.size()) break;
+            if(++tmpVar >= lineageLog.num_records()) break;
             init_worm(tmpVar, varVals, 13*(tmpVar^2+tmpVar+50) % ubX.val, 17*(tmpVar^2+tmpVar+100) % ubY.val, 5);
         }
         #undef init_worm
@@ -333,13 +333,13 @@ void gen_demo_cells_video1(int scenarioNum){
         set_sim_params({&ubX, &ubY, &dayNightMode, &maxSunEnergyPerSec, &gndEnergyPerIncrease, &maxGndEnergy},
             {30, 20, DAY_NIGHT_ALWAYS_DAY_MODE, 50, 0, 1});
         varVals.clear(); varVals = gen_std_stats("plant", 15, 10, 8, 40000, 40000, 16);
-        pCellsHist[0]->set_int_stats(varVals, 0);
-        pCellsHist[0]->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->set_int_stats(varVals, 0);
+        get_cell_by_id(0)->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
         #define init_predator(cellNum, varVals, posX, posY, dia, targetX, targetY, attackCooldown){ \
             varVals.clear(); varVals = gen_std_stats("predator", posX, posY, dia, 1000, 10000, dia*dia/2, 100, 1, attackCooldown); \
-            pCellsHist[cellNum]->set_int_stats(varVals, 0); \
-            pCellsHist[cellNum]->preplan_shortest_path_to_point(posX, posY, targetX, targetY, true, true, false); \
-            pCellsHist[cellNum]->force_decision(1000, 0, 0, IDLE_MODE, true, false, false); \
+            get_cell_by_id(cellNum)->set_int_stats(varVals, 0); \
+            get_cell_by_id(cellNum)->preplan_shortest_path_to_point(posX, posY, targetX, targetY, true, true, false); \
+            get_cell_by_id(cellNum)->force_decision(1000, 0, 0, IDLE_MODE, true, false, false); \
         }
         init_predator(1, varVals,  6,  9, 4, 16,  8, 10);
         init_predator(2, varVals,  3,  3, 2, 12, 10, 10);
@@ -359,15 +359,15 @@ void gen_demo_cells_video1(int scenarioNum){
             {30, 20, DAY_NIGHT_ALWAYS_DAY_MODE, 0, 0, 1});
         #define init_predator(cellNum, varVals, posX, posY, dia, targetX, targetY, delay, maxHealth){ \
             varVals.clear(); varVals = gen_std_stats("predator", posX, posY, dia, 1000*dia, 5000*dia, maxHealth, 100, dia*dia); \
-            pCellsHist[cellNum]->set_int_stats(varVals, 0); \
-            pCellsHist[cellNum]->force_decision(delay, 0, 0, IDLE_MODE, true, false, false); \
-            pCellsHist[cellNum]->preplan_shortest_path_to_point(posX, posY, targetX, targetY, true, true, false); \
-            pCellsHist[cellNum]->preplan_shortest_path_to_point(targetX, targetY, posX, posY, true, true, false); \
-            pCellsHist[cellNum]->force_decision(10, 0, 0, IDLE_MODE, false, false, false); \
-            pCellsHist[cellNum]->preplan_shortest_path_to_point(posX, posY, targetX, targetY, true, true, false); \
-            pCellsHist[cellNum]->force_decision(10, 0, 0, IDLE_MODE, false, false, false); \
-            pCellsHist[cellNum]->preplan_shortest_path_to_point(targetX, targetY, posX, posY, false, false, false); \
-            pCellsHist[cellNum]->force_decision(1000, 0, 0, IDLE_MODE, false, false, false); \
+            get_cell_by_id(cellNum)->set_int_stats(varVals, 0); \
+            get_cell_by_id(cellNum)->force_decision(delay, 0, 0, IDLE_MODE, true, false, false); \
+            get_cell_by_id(cellNum)->preplan_shortest_path_to_point(posX, posY, targetX, targetY, true, true, false); \
+            get_cell_by_id(cellNum)->preplan_shortest_path_to_point(targetX, targetY, posX, posY, true, true, false); \
+            get_cell_by_id(cellNum)->force_decision(10, 0, 0, IDLE_MODE, false, false, false); \
+            get_cell_by_id(cellNum)->preplan_shortest_path_to_point(posX, posY, targetX, targetY, true, true, false); \
+            get_cell_by_id(cellNum)->force_decision(10, 0, 0, IDLE_MODE, false, false, false); \
+            get_cell_by_id(cellNum)->preplan_shortest_path_to_point(targetX, targetY, posX, posY, false, false, false); \
+            get_cell_by_id(cellNum)->force_decision(1000, 0, 0, IDLE_MODE, false, false, false); \
         }
         init_predator(0, varVals, 15, 10, 8, 15, 10, 1000, 56);
         init_predator(1, varVals, 15,  3, 2, 15,  6, 10,    4);
@@ -388,8 +388,8 @@ void gen_demo_cells_video1(int scenarioNum){
         set_sim_params({&ubX, &ubY, &dayNightMode, &maxSunEnergyPerSec, &gndEnergyPerIncrease, &maxGndEnergy},
             {6, 3, DAY_NIGHT_ALWAYS_DAY_MODE, 100, 0, 1});
         varVals.clear(); varVals = gen_std_stats("plant", 1, 1, 2, 2500, 5000);
-        pCellsHist[0]->set_int_stats(varVals, 0);
-        pCellsHist[0]->force_decision(1000, 0, 0, IDLE_MODE, false, false, true);
+        get_cell_by_id(0)->set_int_stats(varVals, 0);
+        get_cell_by_id(0)->force_decision(1000, 0, 0, IDLE_MODE, false, false, true);
         scenario_postcode();
         break;
 
@@ -399,9 +399,9 @@ void gen_demo_cells_video1(int scenarioNum){
         set_sim_params({&ubX, &ubY, &dayNightMode, &maxSunEnergyPerSec, &gndEnergyPerIncrease, &maxGndEnergy},
             {6, 3, DAY_NIGHT_ALWAYS_DAY_MODE, 0, 0, 1});
         varVals.clear(); varVals = gen_std_stats("plant", 1, 1, 2, 5000, 5000, 600);
-        pCellsHist[0]->set_int_stats(varVals, 0);
-        pCellsHist[0]->force_decision(   5, 0, 0, IDLE_MODE, false, false, false);
-        pCellsHist[0]->force_decision(1000, 0, 0, IDLE_MODE, false, false, true);
+        get_cell_by_id(0)->set_int_stats(varVals, 0);
+        get_cell_by_id(0)->force_decision(   5, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(1000, 0, 0, IDLE_MODE, false, false, true);
         scenario_postcode();
         break;
 
@@ -412,10 +412,10 @@ void gen_demo_cells_video1(int scenarioNum){
             {80, 40, DAY_NIGHT_ALWAYS_DAY_MODE, 0, 0, 1});
         #define gen_worm(cellNum, posX, posY, _runSpeed){ \
             varVals.clear(); varVals = gen_std_stats("worm", posX, posY, 9, 3000, 3000, 1, 100, 1, 10, 0, 0, 0, 0, _runSpeed, 0); \
-            pCellsHist[cellNum]->set_int_stats(varVals, 0); \
-            pCellsHist[cellNum]->force_decision(1000, 0, 0, RUN_MODE, false, false, false); \
+            get_cell_by_id(cellNum)->set_int_stats(varVals, 0); \
+            get_cell_by_id(cellNum)->force_decision(1000, 0, 0, RUN_MODE, false, false, false); \
         }
-        for(tmpVar = 0; tmpVar < pCellsHist.size(); tmpVar++){
+        for(tmpVar = 0; tmpVar < lineageLog.num_records(); tmpVar++){
             gen_worm(tmpVar, 10, 10*tmpVar+5, 3*tmpVar);
         }
         #undef gen_worm
@@ -428,12 +428,12 @@ void gen_demo_cells_video1(int scenarioNum){
         set_sim_params({&ubX, &ubY, &dayNightMode, &maxSunEnergyPerSec, &gndEnergyPerIncrease, &maxGndEnergy},
             {15, 10, DAY_NIGHT_ALWAYS_DAY_MODE, 0, 0, 1});
         varVals.clear(); varVals = gen_std_stats("plant", 4, 4, 6, 10000, 10000, 200);
-        pCellsHist[0]->set_int_stats(varVals, 0);
-        pCellsHist[0]->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->set_int_stats(varVals, 0);
+        get_cell_by_id(0)->force_decision(1000, 0, 0, IDLE_MODE, false, false, false);
         varVals.clear(); varVals = gen_std_stats("predator", 9, 9, 2, 5000, 5000, 1, 100, 50, 0);
-        pCellsHist[1]->set_int_stats(varVals, 0);
-        pCellsHist[1]->force_decision(3, 225, 0, RUN_MODE, true, false, false);
-        pCellsHist[1]->force_decision(1000, 0, 0, IDLE_MODE, true, false, false);
+        get_cell_by_id(1)->set_int_stats(varVals, 0);
+        get_cell_by_id(1)->force_decision(3, 225, 0, RUN_MODE, true, false, false);
+        get_cell_by_id(1)->force_decision(1000, 0, 0, IDLE_MODE, true, false, false);
         #undef gen_cell
         scenario_postcode();
         break;
@@ -449,7 +449,7 @@ void gen_demo_cells_video1(int scenarioNum){
         #define gen_cell(cellNum, cellType, posX, posY, dia, initEnergy, maxEnergy){ \
             varVals.clear(); varVals = gen_std_stats(cellType, posX, posY, dia, initEnergy, maxEnergy, dia, 100, dia, 10, 0, 0, 0, 1, 2, 0); \
             varVals["rngAi_pctChanceIdle"] = 10; varVals["rngAi_pctChanceWalk"] = 30; \
-            pCellsHist[cellNum]->set_int_stats(varVals, 0); \
+            get_cell_by_id(cellNum)->set_int_stats(varVals, 0); \
         }
         gen_cell(0, "plant", 5, 5, 6, 10000, 10000);
         gen_cell(1, "worm", 35, 15, 2, 10000, 10000);
@@ -469,10 +469,10 @@ void gen_demo_cells_video1(int scenarioNum){
         #define gen_cell(cellNum, cellType, posX, posY, dia, initEnergy, maxEnergy, visionDist, attack){ \
             varVals.clear(); varVals = gen_std_stats(cellType, posX, posY, dia, initEnergy, maxEnergy, dia, 100, attack, 10, 0, 0, 0, 1, 2, visionDist); \
             varVals["rngAi_pctChanceIdle"] = 10; varVals["rngAi_pctChanceWalk"] = 30; \
-            pCellsHist[cellNum]->set_int_stats(varVals, 0); \
+            get_cell_by_id(cellNum)->set_int_stats(varVals, 0); \
         }
         gen_cell(0, "predator", ubX.val/2, ubY.val/2, 2, 1000, 10000, 5, 1);
-        for(tmpVar = 1; tmpVar < pCellsHist.size();){
+        for(tmpVar = 1; tmpVar < lineageLog.num_records();){
             gen_cell(tmpVar++, "plant", rand() % (ubX.val-2) + 1, rand() % (ubY.val-2) + 1, 2, 1000, 10000, 0, 0);
             gen_cell(tmpVar++,  "worm", rand() % (ubX.val-2) + 1, rand() % (ubY.val-2) + 1, 2, 1000, 10000, 0, 0);
         }
@@ -491,19 +491,19 @@ void gen_demo_cells_video1(int scenarioNum){
         #define gen_cell(cellNum, cellType, posX, posY, dia, initEnergy, maxEnergy, visionDist, attack, maxHealth){ \
             varVals.clear(); varVals = gen_std_stats(cellType, posX, posY, dia, initEnergy, maxEnergy, maxHealth, 100, attack, 10, 0, 0, 0, 1, 2, visionDist); \
             varVals["rngAi_pctChanceIdle"] = 10; varVals["rngAi_pctChanceWalk"] = 30; \
-            pCellsHist[cellNum]->set_int_stats(varVals, 0); \
+            get_cell_by_id(cellNum)->set_int_stats(varVals, 0); \
         }
-        #define force_leftward_movement(cellNum, numFrames, _speedMode) pCellsHist[cellNum]->force_decision(numFrames, 180, 0, _speedMode, false, false, false)
+        #define force_leftward_movement(cellNum, numFrames, _speedMode) get_cell_by_id(cellNum)->force_decision(numFrames, 180, 0, _speedMode, false, false, false)
         //gen_cell(0, "worm", 20, 10, 2, 10000, 10000, 0, 0);
         gen_cell(0, "predator", 20, 10, 2, 1000, 10000, 6, 1, 2);
-        pCellsHist[0]->force_decision(10, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(0)->force_decision(10, 0, 0, IDLE_MODE, false, false, false);
         gen_cell(1,  "worm", 17, 10, 2, 500, 5000, 0, 0, 2000);
-        pCellsHist[1]->force_decision(10, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(1)->force_decision(10, 0, 0, IDLE_MODE, false, false, false);
         gen_cell(2, "worm", 23, 10, 2, 500, 5000, 0, 0, 2);
-        pCellsHist[2]->force_decision(100, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(2)->force_decision(100, 0, 0, IDLE_MODE, false, false, false);
         gen_cell(3, "plant", 20,  7, 2, 500, 5000, 0, 0, 2);
         gen_cell(4, "predator", 20, 13, 2, 500, 5000, 0, 0, 2);
-        pCellsHist[4]->force_decision(100, 0, 0, IDLE_MODE, false, false, false);
+        get_cell_by_id(4)->force_decision(100, 0, 0, IDLE_MODE, false, false, false);
         gen_cell(5, "worm", 35, 10, 2, 500, 5000, 0, 0, 20);
         force_leftward_movement(5, 100, IDLE_MODE);
         force_leftward_movement(5,  50, WALK_MODE);
@@ -545,7 +545,7 @@ void gen_demo_cells_video1(int scenarioNum){
             varVals.clear(); varVals = gen_std_stats(cellType, posX, posY, dia, initEnergy, maxEnergy, maxHealth, 100, attack, 10, 0, 0, 0, 1, 2, visionDist); \
             varVals["rngAi_pctChanceIdle"] = 0; varVals["rngAi_pctChanceWalk"] = 50; \
             varVals["rngAi_pctChanceToChangeDir"] = 5; varVals["rngAi_pctChanceToChangeSpeed"] = 50; \
-            pCellsHist[cellNum]->set_int_stats(varVals, 0); \
+            get_cell_by_id(cellNum)->set_int_stats(varVals, 0); \
         }
         gen_cell(0, "predator", 40, 20, 2, 5000, 10000, 8, 1, 1);
         gen_cell(1, "plant",  4, 12, 2, 500, 5000, 0, 0, 1);
@@ -553,7 +553,7 @@ void gen_demo_cells_video1(int scenarioNum){
         gen_cell(3, "plant", 64,  2, 2, 500, 5000, 0, 0, 1);
         gen_cell(4, "plant", 10, 25, 2, 500, 5000, 0, 0, 1);
         //gen_cell(5, "worm",  40, 20, 2, 500, 5000, 0, 0, 1);
-        //pCellsHist[5]->force_decision(10, 305, 0, RUN_MODE, false, false, false);
+        //get_cell_by_id(5)->force_decision(10, 305, 0, RUN_MODE, false, false, false);
         gen_cell(5, "plant", 70, 15, 2, 500, 5000, 0, 0, 1);
         gen_cell(6, "plant", 15, 38, 2, 500, 5000, 0, 0, 1);
         gen_cell(7, "plant", 45, 33, 2, 500, 5000, 0, 0, 1);
@@ -722,30 +722,37 @@ void do_video1(){
         default:
         if(kF1g <= frameNum && frameNum < kF1h){
             if(frameNum == kF1g + 1) init_sim_gnd_energy(0);
-            else if(frameNum % 5 == 0) simGndEnergy[1][3] += maxGndEnergy.val / 10;
+            else if(frameNum % 5 == 0) simGndEnergy.set(3, 1, simGndEnergy.get(3, 1) + maxGndEnergy.val / 10);
         } else if(kF1h <= frameNum && frameNum < kF1i){
             if(frameNum == kF1h + 1) init_sim_gnd_energy(0);
-            else if(frameNum % 5 == 0) simGndEnergy[1][4] += maxGndEnergy.val / 10;
+            else if(frameNum % 5 == 0) simGndEnergy.set(4, 1, simGndEnergy.get(4, 1) + maxGndEnergy.val / 10);
         } else if(kF1i <= frameNum && frameNum < kF2start){
             if(frameNum == kF1i + 1) init_sim_gnd_energy(0);
             else if(frameNum % 5 == 0){
                 for(int i = 0; i <= 2; i++){
                     for(int j = 3; j <= 5; j++){
-                        simGndEnergy[i][j] += maxGndEnergy.val / 10;
-                        simGndEnergy[i][j] = min_int(simGndEnergy[i][j], maxGndEnergy.val);
+                        simGndEnergy.set(j, i, min_int(simGndEnergy.get(j, i) + maxGndEnergy.val / 10, maxGndEnergy.val));
                     }
                 }
             }
         } else if(kF2b <= frameNum && frameNum < kF2d){
-            pCellsHist[0]->health--;
-            pCellsHist[0]->energy = pCellsHist[0]->stats["maxEnergy"][0] / 9;
-            if(pCellsHist[1]->energy < pCellsHist[1]->stats["maxEnergy"][0] / 10){
-                pCellsHist[1]->energy += pCellsHist[1]->stats["maxEnergy"][0] / 100;
-            } else {
-                pCellsHist[1]->energy += pCellsHist[1]->stats["maxEnergy"][0] / 25;
+            // NOTE: Cells which were removed are no longer in memory
+            Cell* pCell0 = get_cell_by_id(0);
+            Cell* pCell1 = get_cell_by_id(1);
+            if(pCell0 != NULL){
+                pCell0->health--;
+                pCell0->energy = pCell0->stats["maxEnergy"][0] / 9;
+            }
+            if(pCell1 != NULL){
+                if(pCell1->energy < pCell1->stats["maxEnergy"][0] / 10){
+                    pCell1->energy += pCell1->stats["maxEnergy"][0] / 100;
+                } else {
+                    pCell1->energy += pCell1->stats["maxEnergy"][0] / 25;
+                }
             }
         } else if(kF2e <= frameNum && frameNum < kF3start){
-            pCellsHist[0]->age += 49;
+            Cell* pCell0 = get_cell_by_id(0);
+            if(pCell0 != NULL) pCell0->age += 49;
         }
         
         if (kF6start <= frameNum) {
@@ -23,6 +23,20 @@ int main(int argc, char* argv[]){
     //testStats();
     //testFrames();
     //testGlobalEnergy();
+    //testPopulationCounts();
+    //testLineageLog();
+    //testMotionSteps();
+    //testDecisionLog();
+    //testSleepingContacts();
+    //testVisionLists();
+    //testPreyIndex();
+    //testSharedBrains();
+    //testSharedGenomes();
+    //testQuantizedAi();
+    //testWorldGrid();
+    //testCellStorageSort();
+    //testRegionCounts();
+    //testTaskGraph();
     //test_SDL();
     //test_event_handler();
     //test_new_tex();
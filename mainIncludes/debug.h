@@ -15,8 +15,15 @@
 //#define DO_VIDEO_FRAMES
 //#define DO_VIDEO_TEXT
 //#define DO_WHITE_TEXT
+//#define DO_OFFSCREEN_VIDEO
+//  Use with DO_VIDEO_FRAMES or DO_VIDEO_TEXT. Draws each frame into memory instead of a window and
+//  writes it to VIDEO_EXPORT_PATH as fast as possible (no user input, so it also works without a display)
 
 #if defined(DO_VIDEO_FRAMES) || defined(DO_VIDEO_TEXT)
 #define DO_VIDEO
 #endif
 
+
+#if defined(DO_OFFSCREEN_VIDEO) && !defined(DO_VIDEO)
+#error "DO_OFFSCREEN_VIDEO needs DO_VIDEO_FRAMES or DO_VIDEO_TEXT"
+#endif
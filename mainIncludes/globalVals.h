@@ -26,63 +26,61 @@ static const int MAX_INT_DEFAULT = 2147483647; // The max value an int can have
 //  where each simulation parameter contains a list of possible values
 void update_global_params();
 int cellRegionNumUbX = -1, cellRegionNumUbY = -1, drawScaleFactor = -1, ubX_px = -1, ubY_px = -1;
+// The standard values of a SimParamInt in ascending order (see SimParamInt::init_standard_possibleVals(...)):
+//  ..., -20, -15, -12, -10, 0, 1, 2, ..., 9, 10, 12, 15, 20, 30, ..., 90, 100, 120, 150, 200, ..., 2*10^9, INT_MAX
+//  There are no values between -10 and 0. Built at compile time and shared by every parameter
+struct SimParamStepTable {
+    static const int MAX_NUM_VALS = 256;
+    int vals[MAX_NUM_VALS];
+    int numVals;
+    constexpr SimParamStepTable() : vals(), numVals(0) {
+        int positiveVals[MAX_NUM_VALS] = {};
+        int numPositiveVals = 0;
+        for(int val = 1; val < 10; val++) positiveVals[numPositiveVals++] = val;
+        int pow10 = 1;
+        for(int mag = 1; mag <= 9; mag++){
+            pow10 *= 10;
+            positiveVals[numPositiveVals++] = pow10;
+            positiveVals[numPositiveVals++] = 12 * (pow10 / 10);
+            positiveVals[numPositiveVals++] = 15 * (pow10 / 10);
+            if(mag == 9) break;
+            for(int digit = 2; digit < 10; digit++) positiveVals[numPositiveVals++] = digit * pow10;
+        }
+        positiveVals[numPositiveVals++] = 2 * pow10;
+        positiveVals[numPositiveVals++] = INT_MAX;
+        for(int i = numPositiveVals - 1; i >= 9; i--) vals[numVals++] = -positiveVals[i];
+        vals[numVals++] = 0;
+        for(int i = 0; i < numPositiveVals; i++) vals[numVals++] = positiveVals[i];
+    }
+};
+constexpr SimParamStepTable SIM_PARAM_STEP_TABLE;
+
 struct SimParamInt{
     int val;
     int valIndex;
     std::vector<int> possibleVals; // Recommended to sort these in ascending order
-    std::map<int, int> nextPossibleVal;
     int lastIncrement = 0; // The last input in the increment_val(...) function (regularly resets to 0)
 
+    // NOTE: The constructors do not call update_global_params(), since the parameters it uses might not
+    //  exist yet. It is called once after all of them are (see areGlobalParamsInit)
     SimParamInt(int initVal, std::vector<int> possibleValues): val(initVal), possibleVals(possibleValues){
-        for(valIndex = 0; valIndex < possibleVals.size(); valIndex++){
-            if(val <= possibleVals[valIndex]) break;
-        }
-        correct_val_and_valIndex();
+        init_valIndex();
         //cout << "valIndex = " << valIndex << ", val: " << val << endl;
     }
 
     SimParamInt(int initVal, int smallestPossibleVal, int largestPossibleVal): val(initVal){
-        init_nextPossibleVal_map();
         init_standard_possibleVals(smallestPossibleVal, largestPossibleVal);
-        for(valIndex = 0; valIndex < possibleVals.size(); valIndex++){
-            if(val <= possibleVals[valIndex]) break;
-        }
-        correct_val_and_valIndex();
+        init_valIndex();
         //cout << "valIndex = " << valIndex << ", val: " << val << endl;
     }
 
-    void init_nextPossibleVal_map(){
-        for(int val = 0; val < 10; val++) nextPossibleVal[val] = val+1;
-        int pow_int(int root, int exponent);
-        #define p(magnitude) pow_int(10,magnitude)
-
-        //MAX_INT_DEFAULT == 2147483647
-        //lb = -2*p(9), ub = 2*p(9);
-        std::vector<int> valsSoFar;
-        nextPossibleVal[0] = 1; valsSoFar.push_back(0);
-        for(int mag = 1; mag < 9; mag++){
-            nextPossibleVal[1*p(mag)] = 12*p(mag-1);    valsSoFar.push_back(1*p(mag));
-            nextPossibleVal[12*p(mag-1)] = 15*p(mag-1); valsSoFar.push_back(12*p(mag-1));
-            nextPossibleVal[15*p(mag-1)] = 2*p(mag);    valsSoFar.push_back(15*p(mag-1));
-            nextPossibleVal[2*p(mag)] = 3*p(mag);       valsSoFar.push_back(2*p(mag));
-            nextPossibleVal[3*p(mag)] = 4*p(mag);       valsSoFar.push_back(3*p(mag));
-            nextPossibleVal[4*p(mag)] = 5*p(mag);       valsSoFar.push_back(4*p(mag));
-            nextPossibleVal[5*p(mag)] = 6*p(mag);       valsSoFar.push_back(5*p(mag));
-            nextPossibleVal[6*p(mag)] = 7*p(mag);       valsSoFar.push_back(6*p(mag));
-            nextPossibleVal[7*p(mag)] = 8*p(mag);       valsSoFar.push_back(7*p(mag));
-            nextPossibleVal[8*p(mag)] = 9*p(mag);       valsSoFar.push_back(8*p(mag));
-            nextPossibleVal[9*p(mag)] = 10*p(mag);      valsSoFar.push_back(9*p(mag));
-        }
-        nextPossibleVal[1*p(9)] = 12*p(8);  valsSoFar.push_back(1*p(9));
-        nextPossibleVal[12*p(8)] = 15*p(8); valsSoFar.push_back(12*p(8));
-        nextPossibleVal[15*p(8)] = 2*p(9);  valsSoFar.push_back(15*p(8));
-        nextPossibleVal[2*p(9)] = INT_MAX;   valsSoFar.push_back(INT_MAX);
-        // Deal with the negative values
-        for(int i = 1; i < valsSoFar.size(); i++){
-            int val = -valsSoFar[i], nextVal = -valsSoFar[i-1];
-            nextPossibleVal[val] = nextVal;
+    // Round val up to the nearest possible value
+    void init_valIndex(){
+        for(valIndex = 0; valIndex < possibleVals.size(); valIndex++){
+            if(val <= possibleVals[valIndex]) break;
         }
-        #undef p
+        correct_valIndex();
+        val = possibleVals[valIndex];
     }
 
     void correct_val_and_valIndex(){
@@ -99,10 +97,10 @@ struct SimParamInt{
 
     void init_standard_possibleVals(int lb, int ub){
         assert(lb <= ub);
-        assert(nextPossibleVal.count(lb));
-        for(int val = lb; val <= ub; val = nextPossibleVal[val]){
-            possibleVals.push_back(val);
-        }
+        const int* pEnd = SIM_PARAM_STEP_TABLE.vals + SIM_PARAM_STEP_TABLE.numVals;
+        const int* pVal = std::lower_bound(SIM_PARAM_STEP_TABLE.vals, pEnd, lb);
+        assert(pVal != pEnd && *pVal == lb);
+        for(; pVal != pEnd && *pVal <= ub; pVal++) possibleVals.push_back(*pVal);
     }
 
     void increment_val(bool doIncrease){
@@ -125,8 +123,8 @@ struct SimParamInt{
 
 // Global Simulation Parameters
 SimParamInt initNumCells(300, 0, 10000);
-SimParamInt ubX(80, 1, 1000); // 120
-SimParamInt ubY(40, 1, 1000); // 80
+SimParamInt ubX(80, 1, 20000); // 120
+SimParamInt ubY(40, 1, 20000); // 80
 // NOTE: The program might not work properly if this is disabled
 static const bool WRAP_AROUND_X = true; // Enforce the constraint 0 <= x < ubX.val
 // NOTE: The program might not work properly if this is disabled
@@ -138,7 +136,6 @@ SimParamInt cellLimit(1000, 0, 10000);
 SimParamInt overcrowdingEnergyCoef(0, 0, 1000); // 1
 // Energy accumulation for all ground spaces
 SimParamInt maxGndEnergy(100, 1, 1000000);
-std::vector<std::vector<int>> simGndEnergy;
 static const int FRAMES_BETWEEN_GND_ENERGY_ACCUMULATION = 10;
 SimParamInt gndEnergyPerIncrease(10, 0, 10000);
 SimParamInt defaultMutationChance(100, 0, 1000);    // 1000 = 100%
@@ -174,6 +171,7 @@ SimParamInt dayNightUbPct(50,{seqOf100(0,1)});
 
 // Initialize SDL
 static const char* WINDOW_TITLE = "Evolution Simulator";
+static const char* LINEAGE_LOG_PATH = "lineage.bin"; // Every cell ever created is recorded here (see LineageLog)
 static const int WINDOW_WIDTH  = 800;       // Try 1540 for full screen and 770 for half screen         // 600; 800;
 static const int WINDOW_HEIGHT = 445;       // Try 700 for full screeen, or 450 for a quarter screen    // 450; 445;
 // I split cells into square regions so I only have to compare the positions
@@ -181,21 +179,58 @@ static const int WINDOW_HEIGHT = 445;       // Try 700 for full screeen, or 450
 // If a region near the bottom or the right side is smaller, then it is absorbed
 //  into the neighboring region(s)
 static const int CELL_REGION_SIDE_LEN = 10;
+// The ground energy and the cell regions are stored in chunks, which are only allocated where they are needed,
+//  so large maps (e.g. 16000 x 16000) only take up memory where the cells are (see worldGrid.h)
+static const int GND_CHUNK_SIDE_LEN = 64; // Pixels
+static const int REGION_CHUNK_SIDE_LEN = 16; // Regions
+// Searches over many regions (e.g. for long-sighted cells) skip the empty blocks of regions (see RegionCounts)
+//  Each level of blocks groups REGION_COUNTS_FANOUT x REGION_COUNTS_FANOUT blocks of the level below it
+static const int REGION_COUNTS_FANOUT = 4;
+static const int REGION_COUNTS_MAX_BASE_SIDE_LEN = 8; // Regions
+// Every this many frames, the cells are moved in memory so cells which are close on the map are close in memory
+//  (see sort_cell_storage()). This does not change their order in pActives
+static const int CELL_STORAGE_SORT_PERIOD = 64;
+// Each cell keeps the cells near its field of view in a list, which is reused until the cell moves more than
+//  this many pixels (see VisionLists). Larger values rebuild the lists less often, but make them longer
+static const int VISION_LIST_SKIN = 2;
 
 int mousePosX = 0, mousePosY = 0;
 static const Uint32 FRAME_DELAY = 20; // ms; frame rate is (1000/FRAME_DELAY) fps; Default 125
 Uint32 frameStart = 0; // The time in ms since the start of the simulation
 Uint32 frameTime = 0; // The amount of time the frame lasted for
 int frameNum = 0; // The frame number of the simulation
+// Offscreen video export (see DO_OFFSCREEN_VIDEO in debug.h)
+//  If the path starts with '|', the rest is run as a command and the frames are piped into it
+//  e.g. "|ffmpeg -y -i - -c:v libx264 -pix_fmt yuv420p video.mp4"
+static const char* VIDEO_EXPORT_PATH = "video.y4m";
+static const bool VIDEO_EXPORT_Y4M = true; // false: a stream of binary PPM (P6) images
+static const int VIDEO_EXPORT_FPS = 1000 / FRAME_DELAY;
+static const int VIDEO_EXPORT_NUM_FRAMES = 20000; // The simulation quits after exporting this many frames
+static const int VIDEO_EXPORT_QUEUE_LEN = 8; // Frames waiting for the writer thread
+static const int VIDEO_EXPORT_FRAME_STRIDE = 1; // Only export every nth frame
+static const bool VIDEO_EXPORT_DROP_FRAMES = false; // true: drop frames instead of waiting when the writer falls behind
+// The number of threads (and therefore per-thread buffers, e.g. spawnBuffers) the simulation phases can use
+static const int NUM_SIM_THREADS = 1;
+// The number of threads the phases of a frame run on (see TaskGraph), including the simulation thread itself
+static const int NUM_TASK_THREADS = 2;
 
 // Manually control cell decisions, frame ticks, etc.
 static const int EVOLUTIONARY_NEURAL_NETWORK_AI_MODE = 0, RNG_BASED_AI_MODE = 1;
 int aiMode = RNG_BASED_AI_MODE;
+// How the neural network AI is evaluated (see AiBrain in ai.h). AI_INFERENCE_INT8 uses the weights quantized to 8 bits
+//  AI_INFERENCE_COMPARE decides with the float network, but also runs the int8 one and reports how often
+//  their decisions differ (see aiQuantizationReport)
+static const int AI_INFERENCE_FLOAT = 0, AI_INFERENCE_INT8 = 1, AI_INFERENCE_COMPARE = 2;
+int aiInferenceMode = AI_INFERENCE_FLOAT;
 bool doCellAi = true;
 bool automateEnergy = true;
 bool enableAutomaticAttack = true;
 bool enableAutomaticSelfDestruct = false;
 bool enableAutomaticCloning = true;
+// Record every cell's decisions, or replay a recorded run without running the AI (see decisionLog.h)
+static const int DECISION_LOG_OFF = 0, DECISION_LOG_RECORD = 1, DECISION_LOG_REPLAY = 2;
+int decisionLogMode = DECISION_LOG_OFF;
+static const char* DECISION_LOG_PATH = "decisions.bin";
 
 // Simulation States: These control the GUI, simulation mode, etc.
 static const int SIM_STATE_UNDEF = -1;
@@ -208,6 +243,11 @@ static const int SIM_STATE_OPTIONS = 4;
 static const int SIM_STATE_INIT = 5;
 static const int SIM_STATE_RESTART = 6;
 int simState = SIM_STATE_UNDEF;
+// Commands from the user while the simulation is running (see get_ui_command(...))
+static const int UI_CMD_NONE = 0, UI_CMD_STEP = 1, UI_CMD_SKIP = 2, UI_CMD_OPTIONS = 3, UI_CMD_CONTINUE = 4, UI_CMD_QUIT = 5;
+// If true, the simulation runs on its own thread and the main (SDL) thread only renders
+//  the latest snapshot of it and handles events (see renderThread.h)
+static const bool DECOUPLE_RENDERING = true;
 
 // The x and y coordinates defining the GUI
 static const std::vector<int> X_VEC_GUI = {0, WINDOW_WIDTH / 3, 2 * WINDOW_WIDTH / 3, 51 * WINDOW_WIDTH / 60, WINDOW_WIDTH};
@@ -220,6 +260,8 @@ std::mt19937 rng{rd()};
 static const int NUM_EAM_ELE = 3;
 static const int REQ_EAM_SUM = 100; // Required sum of all elements in EAM
 static const int ID_LEN = 40;
+static const int ID_NUM_WORDS = (ID_LEN + 63) / 64; // Cell ids are packed into 64-bit words
+static const uint64_t ID_LAST_WORD_MASK = (ID_LEN % 64 == 0) ? ~0ULL : (1ULL << (ID_LEN % 64)) - 1;
 static const int IDLE_MODE = 0, WALK_MODE = 1, RUN_MODE = 2;
 static const int EAM_SUN = 0, EAM_GND = 1, EAM_CELLS = 2;
     //  Indices for each element in EAM.
@@ -228,6 +270,12 @@ static const int EAM_SUN = 0, EAM_GND = 1, EAM_CELLS = 2;
     //  EAM_CELLS means energy from other cells
 static const int CELL_TYPE_PLANT = 0, CELL_TYPE_WORM = 1, CELL_TYPE_PREDATOR = 2, CELL_TYPE_MUTANT = 3;
 static const int CELL_TYPE_GENERIC = 4, CELL_TYPE_PLANT_WORM_PREDATOR_OR_MUTANT = 5;
+static const int NUM_CELL_ARCHETYPES = 5; // CELL_TYPE_PLANT, ..., CELL_TYPE_GENERIC
+static const int CONTACT_ALIVE = 0x01, CONTACT_TOUCHING = 0x02, CONTACT_REPELLING = 0x04;
+    //  Bit flags for each entry of the per-frame contact list (see ContactList)
+    //  CONTACT_ALIVE means the other cell is alive
+    //  CONTACT_TOUCHING means the cells are close enough to attack, eat, or share sunlight
+    //  CONTACT_REPELLING means the cells are close enough to push each other apart
 std::discrete_distribution<int> availableCellTypes = {1, 1, 1, 0}; // TODO: Add back in the mutant cell type when appropriate
     // Corresponds to {CELL_TYPE_PLANT, CELL_TYPE_WORM, CELL_TYPE_PREDATOR, CELL_TYPE_MUTANT};
     // This variable is where the cell types ratio goes
@@ -269,6 +317,8 @@ void update_global_params(){
     ubY_px = ubY.val * drawScaleFactor;
     return;
 }
+// The SimParamInt constructors leave this to be done once every parameter exists
+bool areGlobalParamsInit = (update_global_params(), true);
 // The values of certain global parameters are restricted by others
 //  NOTE: This is updated so that the SimIntParam variable automatically does this
 void enforce_global_param_constraints(){
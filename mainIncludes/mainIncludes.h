@@ -29,7 +29,19 @@
 
 
 // Initialize SDL Frame Rendering, Textures, etc.
+#ifdef DO_OFFSCREEN_VIDEO
+// There is no window. Every frame is drawn into this surface instead
+SDL_Surface* P_OFFSCREEN_SURFACE = NULL;
+#endif
 SDL_Window* init_SDL_window(){
+    #ifdef DO_OFFSCREEN_VIDEO
+    // No display is needed, but SDL still has to be initialized for the events and the timer
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+    SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_EVENTS);
+    P_OFFSCREEN_SURFACE = SDL_CreateRGBSurfaceWithFormat(0, WINDOW_WIDTH, WINDOW_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+    assert(P_OFFSCREEN_SURFACE != NULL);
+    return NULL;
+    #endif
     SDL_Init(SDL_INIT_EVERYTHING);
     SDL_Window* pWindow = SDL_CreateWindow(
         WINDOW_TITLE, 0, 20, WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_ALLOW_HIGHDPI
@@ -39,9 +51,13 @@ SDL_Window* init_SDL_window(){
 }
 SDL_Window* P_WINDOW = init_SDL_window();
 SDL_Renderer* init_SDL_renderer(){
+    #ifdef DO_OFFSCREEN_VIDEO
+    SDL_Renderer* pRenderer = SDL_CreateSoftwareRenderer(P_OFFSCREEN_SURFACE);
+    #else
     SDL_Renderer* pRenderer = SDL_CreateRenderer(
         P_WINDOW, -1, SDL_RENDERER_ACCELERATED
     );
+    #endif
     assert(pRenderer != NULL);
     SDL_SetRenderDrawBlendMode(pRenderer, SDL_BLENDMODE_BLEND);
     return pRenderer;
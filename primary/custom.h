@@ -57,13 +57,87 @@ void print_1d_vec(std::string vecName, std::vector<float> vec){
     cout << " }\n";
 }
 
+// FNV-1a hash. Pass the previous result as hash to hash several pieces of data together
+uint64_t hash_bytes(const void* pData, size_t numBytes, uint64_t hash = 14695981039346656037ULL){
+    const unsigned char* pBytes = (const unsigned char*)pData;
+    for(size_t i = 0; i < numBytes; i++){
+        hash ^= pBytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// A read-only view of contiguous elements which never copies them (C++17 has no std::span)
+//  NOTE: The view is invalidated if the underlying vector reallocates (e.g. after push_back)
+template <typename T>
+struct ConstSpan {
+    const T* pData = NULL;
+    size_t len = 0;
+
+    ConstSpan(){}
+    ConstSpan(const T* _pData, size_t _len) : pData(_pData), len(_len) {}
+    ConstSpan(const std::vector<T>& vec) : pData(vec.data()), len(vec.size()) {}
+
+    const T& operator[](size_t i) const { return pData[i]; }
+    size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+    const T* begin() const { return pData; }
+    const T* end() const { return pData + len; }
+};
+
+
+
+// Sine and cosine of every integer degree in [0, 360), evaluated at compile time
+//  NOTE: This relies on GCC evaluating std::sin and std::cos in constant expressions.
+//  Each value is identical to sin(deg * PI / 180) cast to float
+struct TrigTable {
+    float sinVals[360];
+    float cosVals[360];
+    constexpr TrigTable() : sinVals(), cosVals() {
+        for(int deg = 0; deg < 360; deg++){
+            sinVals[deg] = std::sin(deg * PI / 180);
+            cosVals[deg] = std::cos(deg * PI / 180);
+        }
+    }
+};
+constexpr TrigTable TRIG_TABLE;
+
+// The same table in fixed point with MOTION_FRAC_BITS fractional bits, for calc_motion_steps(...)
+static const int MOTION_FRAC_BITS = 24;
+static const int MOTION_MAX_EXACT_SPEED = 1000; // Checked exhaustively by testMotionSteps()
+struct MotionStepTable {
+    int32_t sinVals[360];
+    int32_t cosVals[360];
+    constexpr MotionStepTable() : sinVals(), cosVals() {
+        for(int deg = 0; deg < 360; deg++){
+            double sinVal = (double)TRIG_TABLE.sinVals[deg] * (1 << MOTION_FRAC_BITS);
+            double cosVal = (double)TRIG_TABLE.cosVals[deg] * (1 << MOTION_FRAC_BITS);
+            sinVals[deg] = (int32_t)(sinVal + (sinVal >= 0 ? 0.5 : -0.5));
+            cosVals[deg] = (int32_t)(cosVal + (cosVal >= 0 ? 0.5 : -0.5));
+        }
+    }
+};
+constexpr MotionStepTable MOTION_STEP_TABLE;
 
+// Calculate how far each cell moves given its speed and its direction in degrees (0 <= dir < 360)
+//  The loop only does integer math on contiguous arrays, so the compiler can vectorize it.
+//  For speeds up to MOTION_MAX_EXACT_SPEED, the results are identical to
+//  (int)(speed * cos_deg(dir)) and (int)(speed * sin_deg(dir))
+void calc_motion_steps(const int* speeds, const int* dirs, int* stepsX, int* stepsY, int numCells){
+    for(int i = 0; i < numCells; i++){
+        int64_t speed = speeds[i];
+        stepsX[i] = speed * MOTION_STEP_TABLE.cosVals[dirs[i]] / (1 << MOTION_FRAC_BITS);
+        stepsY[i] = speed * MOTION_STEP_TABLE.sinVals[dirs[i]] / (1 << MOTION_FRAC_BITS);
+    }
+}
 
 // Modified <cmath> functions
 float sin_deg(int input){
+    if(0 <= input && input < 360) return TRIG_TABLE.sinVals[input];
     return sin(input * PI / 180);
 }
 float cos_deg(int input){
+    if(0 <= input && input < 360) return TRIG_TABLE.cosVals[input];
     return cos(input * PI / 180);
 }
 float tan_deg(int input){
@@ -163,6 +237,69 @@ float calc_distance_between_points(int posX, int posY, int targetX, int targetY)
     return sqrt(dx*dx + dy*dy);
 }
 
+// Shortest signed offset d on a ring of length ub (i.e. with screen wrapping), assuming -2*ub < d < 2*ub
+//  Branchless. If 2*|d| == ub, d is kept as is. Pass ub = 0 for an axis which does not wrap
+inline int wrap_offset(int d, int ub){
+    return d - ub*(2*d > ub) + ub*(2*d < -ub);
+}
+// Scratch arrays (SoA) for calc_wrapped_sq_distances(...)
+struct PointOffsets {
+    std::vector<int> xs, ys; // Input points
+    std::vector<int> dXs, dYs, sqDists; // Outputs
+    void resize(int numPoints){
+        xs.resize(numPoints); ys.resize(numPoints);
+        dXs.resize(numPoints); dYs.resize(numPoints); sqDists.resize(numPoints);
+    }
+};
+// Offsets and squared distances (accounting for screen wrapping) from (x0, y0) to every point in offsets.xs and offsets.ys
+//  The loop is branchless, so the compiler can vectorize it. Only take the sqrt where the actual distance is needed
+void calc_wrapped_sq_distances(int x0, int y0, PointOffsets& offsets){
+    int numPoints = offsets.xs.size();
+    int wrapUbX = WRAP_AROUND_X ? ubX.val : 0;
+    int wrapUbY = WRAP_AROUND_Y ? ubY.val : 0;
+    const int* xs = offsets.xs.data();
+    const int* ys = offsets.ys.data();
+    int* dXs = offsets.dXs.data();
+    int* dYs = offsets.dYs.data();
+    int* sqDists = offsets.sqDists.data();
+    for(int i = 0; i < numPoints; i++){
+        int dX = wrap_offset(xs[i] - x0, wrapUbX);
+        int dY = wrap_offset(ys[i] - y0, wrapUbY);
+        dXs[i] = dX;
+        dYs[i] = dY;
+        sqDists[i] = dX*dX + dY*dY;
+    }
+}
+
+// Position along the Z-order (Morton) curve, i.e. the bits of x and y interleaved
+//  Points which are close on the map are mostly close on the curve. Only the lowest 16 bits of x and y are used
+inline uint32_t calc_morton_code(int x, int y){
+    auto spread_bits = [](uint32_t val){
+        val &= 0xffff;
+        val = (val | (val << 8)) & 0x00ff00ff;
+        val = (val | (val << 4)) & 0x0f0f0f0f;
+        val = (val | (val << 2)) & 0x33333333;
+        val = (val | (val << 1)) & 0x55555555;
+        return val;
+    };
+    return spread_bits(x) | (spread_bits(y) << 1);
+}
+// Sort {key, value} pairs by key, 8 bits at a time. Stable, so pairs with the same key keep their order
+void radix_sort_by_key(std::vector<std::pair<uint32_t, int>>& items){
+    static thread_local std::vector<std::pair<uint32_t, int>> buffer;
+    int numItems = items.size();
+    buffer.resize(numItems);
+    for(int shift = 0; shift < 32; shift += 8){
+        int firstIndex[257] = {};
+        for(auto& item : items) firstIndex[((item.first >> shift) & 0xff) + 1]++;
+        // Nothing to do if every key has the same 8 bits here
+        if(numItems == 0 || firstIndex[((items[0].first >> shift) & 0xff) + 1] == numItems) continue;
+        for(int i = 0; i < 256; i++) firstIndex[i+1] += firstIndex[i];
+        for(auto& item : items) buffer[firstIndex[(item.first >> shift) & 0xff]++] = item;
+        items.swap(buffer);
+    }
+}
+
 // Modified probability and statistic functions
 float std_uniform_dist(std::mt19937& rng){
     std::uniform_real_distribution<float> distrib(0,1);
@@ -0,0 +1,224 @@
+// A compact log of every decision the cells make, so a run can be replayed without the AI
+//  (i.e. no vision queries and no neural networks). See decisionLogMode in globalVals.h
+// The file is a DecisionLogHeader, the simulation parameters, then one entry per frame:
+//  a varint with the number of decisions, the decisions (see write_decision(...)), and a uint32 seed
+//  Everything random after the decisions (births, mutations, etc.) is drawn from that seed,
+//  so a replay only has to reseed at the same point instead of logging every draw
+#ifndef MAIN_INCLUDES_H
+#include "../mainIncludes/mainIncludes.h"
+#define MAIN_INCLUDES_H
+#endif
+
+
+// What a cell decided to do in one frame (see Cell::set_ai_outputs(...))
+struct CellDecision {
+    int speedDir = 0, cloningDirection = 0, speedMode = IDLE_MODE;
+    bool doAttack = false, doSelfDestruct = false, doCloning = false;
+    bool clampedState = false; // Deciding clamped the cell's energy or health (see Cell::enforce_valid_cell(...))
+};
+
+struct DecisionLogHeader {
+    char magic[8] = {'W', 'R', 'D', 'E', 'C', 'I', 'D', 'E'};
+    uint32_t version = 1;
+    uint32_t numParams = 0; // The number of int32 parameters following the header
+    uint32_t initSeed = 0; // Used to generate the initial cells
+    uint32_t reserved = 0;
+};
+
+struct DecisionLog {
+    // Each decision starts with one byte of flags. The directions and speed mode are
+    //  only written if they changed since the cell's previous decision
+    static const int SPEED_DIR_CHANGED = 0x01, CLONING_DIR_CHANGED = 0x02, SPEED_MODE_CHANGED = 0x04;
+    static const int DO_ATTACK = 0x08, DO_SELF_DESTRUCT = 0x10, DO_CLONING = 0x20, CLAMPED_STATE = 0x40;
+
+    FILE* pFile = NULL;
+    int mode = DECISION_LOG_OFF;
+    std::vector<unsigned char> frameBytes; // Recording: the current frame, written all at once
+    int numFrames = 0;
+    int64_t numBytes = 0;
+
+    bool is_recording(){ return mode == DECISION_LOG_RECORD; }
+    bool is_replaying(){ return mode == DECISION_LOG_REPLAY; }
+
+    // Every parameter that changes how a run plays out. A replay restores all of them
+    std::vector<SimParamInt*> get_logged_sim_params(){
+        return {&initNumCells, &ubX, &ubY, &cellLimit, &overcrowdingEnergyCoef, &maxGndEnergy,
+            &gndEnergyPerIncrease, &defaultMutationChance, &defaultMutationAmt, &maxSunEnergyPerSec,
+            &dayLenSec, &dayNightMode, &dayNightExponentPct, &dayNightLbPct, &dayNightUbPct, &forceDampingFactor};
+    }
+    std::vector<bool*> get_logged_flags(){
+        return {&doCellAi, &automateEnergy, &enableAutomaticAttack, &enableAutomaticSelfDestruct, &enableAutomaticCloning};
+    }
+
+    // Call before the initial cells are generated. Replaying restores the recorded parameters
+    void begin(int _mode, const char* path){
+        close();
+        if(_mode == DECISION_LOG_OFF) return;
+        pFile = fopen(path, _mode == DECISION_LOG_RECORD ? "wb" : "rb");
+        if(pFile == NULL){
+            std::cout << "WARNING: Could not open " << path << ". Decisions will not be " << (_mode == DECISION_LOG_RECORD ? "recorded\n" : "replayed\n");
+            return;
+        }
+        mode = _mode;
+        numFrames = 0;
+        numBytes = 0;
+        std::vector<SimParamInt*> simParams = get_logged_sim_params();
+        std::vector<bool*> flags = get_logged_flags();
+        std::vector<int32_t> params;
+        DecisionLogHeader header;
+        if(is_recording()){
+            header.initSeed = rd();
+            params.push_back(aiMode);
+            for(auto pParam : simParams) params.push_back(pParam->val);
+            for(auto pFlag : flags) params.push_back(*pFlag);
+            header.numParams = params.size();
+            fwrite(&header, sizeof(header), 1, pFile);
+            fwrite(params.data(), sizeof(int32_t), params.size(), pFile);
+        } else {
+            DecisionLogHeader expected;
+            bool isValid = fread(&header, sizeof(header), 1, pFile) == 1;
+            isValid = isValid && memcmp(header.magic, expected.magic, sizeof(expected.magic)) == 0 && header.version == expected.version;
+            isValid = isValid && header.numParams == 1 + simParams.size() + flags.size();
+            if(isValid){
+                params.resize(header.numParams);
+                isValid = fread(params.data(), sizeof(int32_t), params.size(), pFile) == params.size();
+            }
+            if(!isValid){
+                std::cout << "WARNING: " << path << " is not a valid decision log. The run will not be replayed\n";
+                close();
+                return;
+            }
+            int paramNum = 0;
+            aiMode = params[paramNum++];
+            for(auto pParam : simParams) pParam->set_val(params[paramNum++]);
+            for(auto pFlag : flags) *pFlag = params[paramNum++];
+        }
+        reseed(header.initSeed);
+    }
+    void close(){
+        if(pFile == NULL) return;
+        if(is_recording()) std::cout << "Recorded the decisions of " << numFrames << " frames (" << numBytes << " bytes)\n";
+        fclose(pFile);
+        pFile = NULL;
+        mode = DECISION_LOG_OFF;
+    }
+    void reseed(uint32_t seed){
+        srand(seed);
+        rng.seed(seed);
+    }
+
+    void push_varint(uint32_t num){
+        while(num >= 0x80){
+            frameBytes.push_back((num & 0x7f) | 0x80);
+            num >>= 7;
+        }
+        frameBytes.push_back(num);
+    }
+    // Returns false at the end of the file
+    bool read_varint(uint32_t& num){
+        num = 0;
+        for(int shift = 0; shift < 35; shift += 7){
+            int byte = getc(pFile);
+            if(byte == EOF) return false;
+            num |= (uint32_t)(byte & 0x7f) << shift;
+            if((byte & 0x80) == 0) return true;
+        }
+        return false;
+    }
+    // Zigzag encoding, so small negative changes are small numbers too
+    static uint32_t encode_delta(int delta){ return ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31); }
+    static int decode_delta(uint32_t num){ return (int)(num >> 1) ^ -(int)(num & 1); }
+
+    // Recording: begin_record_frame(...), write_decision(...) once per decision, then end_record_frame()
+    void begin_record_frame(int numDecisions){
+        assert(is_recording());
+        frameBytes.clear();
+        push_varint(numDecisions);
+    }
+    // prev is the cell's decision from the previous frame
+    void write_decision(const CellDecision& prev, const CellDecision& cur){
+        int flags = 0;
+        if(cur.speedDir != prev.speedDir) flags |= SPEED_DIR_CHANGED;
+        if(cur.cloningDirection != prev.cloningDirection) flags |= CLONING_DIR_CHANGED;
+        if(cur.speedMode != prev.speedMode) flags |= SPEED_MODE_CHANGED;
+        if(cur.doAttack) flags |= DO_ATTACK;
+        if(cur.doSelfDestruct) flags |= DO_SELF_DESTRUCT;
+        if(cur.doCloning) flags |= DO_CLONING;
+        if(cur.clampedState) flags |= CLAMPED_STATE;
+        frameBytes.push_back(flags);
+        if(flags & SPEED_DIR_CHANGED) push_varint(encode_delta(cur.speedDir - prev.speedDir));
+        if(flags & CLONING_DIR_CHANGED) push_varint(encode_delta(cur.cloningDirection - prev.cloningDirection));
+        if(flags & SPEED_MODE_CHANGED) frameBytes.push_back(cur.speedMode);
+    }
+    // Draws the seed for the rest of the frame
+    void end_record_frame(){
+        assert(is_recording());
+        uint32_t seed = rng();
+        fwrite(frameBytes.data(), 1, frameBytes.size(), pFile);
+        fwrite(&seed, sizeof(seed), 1, pFile);
+        numBytes += frameBytes.size() + sizeof(seed);
+        numFrames++;
+        reseed(seed);
+    }
+
+    // Replaying: begin_replay_frame(...), read_decision(...) once per decision, then end_replay_frame()
+    //  Returns false (and stops replaying) if the log ended or does not match the simulation anymore
+    bool begin_replay_frame(int numDecisions){
+        assert(is_replaying());
+        uint32_t numLogged = 0;
+        if(!read_varint(numLogged)){
+            std::cout << "The decision log ended after " << numFrames << " frames. The cells decide for themselves from now on\n";
+            close();
+            return false;
+        }
+        if((int)numLogged != numDecisions){
+            std::cout << "WARNING: The decision log expected " << numLogged << " decisions in frame " << numFrames << " but there are " << numDecisions << ". Replaying stopped\n";
+            close();
+            return false;
+        }
+        return true;
+    }
+    // Returns false (and stops replaying) if the log ends in the middle of the decision, in which case cur is left alone
+    bool read_decision(const CellDecision& prev, CellDecision& cur){
+        CellDecision decision = prev;
+        uint32_t num = 0;
+        int flags = getc(pFile);
+        bool isValid = flags != EOF;
+        if(isValid && (flags & SPEED_DIR_CHANGED)){
+            isValid = read_varint(num);
+            decision.speedDir = prev.speedDir + decode_delta(num);
+        }
+        if(isValid && (flags & CLONING_DIR_CHANGED)){
+            isValid = read_varint(num);
+            decision.cloningDirection = prev.cloningDirection + decode_delta(num);
+        }
+        if(isValid && (flags & SPEED_MODE_CHANGED)){
+            int speedMode = getc(pFile);
+            isValid = speedMode != EOF;
+            decision.speedMode = speedMode;
+        }
+        if(!isValid){
+            std::cout << "The decision log ended in the middle of frame " << numFrames << ". The cells decide for themselves from now on\n";
+            close();
+            return false;
+        }
+        decision.doAttack = flags & DO_ATTACK;
+        decision.doSelfDestruct = flags & DO_SELF_DESTRUCT;
+        decision.doCloning = flags & DO_CLONING;
+        decision.clampedState = flags & CLAMPED_STATE;
+        cur = decision;
+        return true;
+    }
+    void end_replay_frame(){
+        uint32_t seed = 0;
+        if(fread(&seed, sizeof(seed), 1, pFile) != 1){
+            // Every decision of the frame was replayed, but the rest of the frame can't be
+            std::cout << "WARNING: The decision log is truncated. The cells decide for themselves from now on\n";
+            close();
+            return;
+        }
+        numFrames++;
+        reseed(seed);
+    }
+};
+DecisionLog decisionLog;
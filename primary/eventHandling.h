@@ -31,26 +31,35 @@ void run_skip_frames(int& simState, unsigned int& autoAdvanceSim, char buttonPre
     std::cout << buttonPressed << " is pressed! Simulation is speeding up for " << autoAdvanceSim << " frames" << endl;
 }
 
-void run_sim_state_step_frames(SDL_Event& windowEvent, bool& pauseSim, unsigned int& autoAdvanceSim, int& simState){
-    SDL_WaitEvent(&windowEvent);
+// A request from the user while the simulation is running
+struct UiCommand {
+    int type = UI_CMD_NONE;
+    int numFrames = 0; // For UI_CMD_SKIP
+    char key = ' '; // The key that requested the command (if any)
+};
+// Translate a key press or a mouse click on the user interface into a command
+UiCommand get_ui_command(SDL_Event& windowEvent){
+    UiCommand command;
     Uint32 mouseClickType = 0;
+    #define set_command(_type, _numFrames, _key) { command.type = _type; command.numFrames = _numFrames; command.key = _key; }
     switch(windowEvent.type){
         case SDL_KEYDOWN:
         switch(windowEvent.key.keysym.sym){
             case SDLK_ESCAPE:
-            simState = SIM_STATE_QUIT;
+            set_command(UI_CMD_QUIT, 0, ' ');
+            break;
             case SDLK_n:
             case SDLK_SPACE:
-            run_step_frames_press_n(pauseSim, autoAdvanceSim);
+            set_command(UI_CMD_STEP, 1, 'n');
             break;
             case SDLK_a:
-            run_skip_frames(simState, autoAdvanceSim, 'a', AUTO_ADVANCE_DEFAULT);
+            set_command(UI_CMD_SKIP, AUTO_ADVANCE_DEFAULT, 'a');
             break;
             case SDLK_s:
-            run_skip_frames(simState, autoAdvanceSim, 's', 10*AUTO_ADVANCE_DEFAULT);
+            set_command(UI_CMD_SKIP, 10*AUTO_ADVANCE_DEFAULT, 's');
             break;
             case SDLK_d:
-            run_skip_frames(simState, autoAdvanceSim, 'd', 20*AUTO_ADVANCE_DEFAULT);
+            set_command(UI_CMD_SKIP, 20*AUTO_ADVANCE_DEFAULT, 'd');
             break;
         }
         break;
@@ -62,16 +71,37 @@ void run_sim_state_step_frames(SDL_Event& windowEvent, bool& pauseSim, unsigned
             if(mousePosY < ubY_px || mousePosX >= X_VEC_GUI[3]) break;
             else{
                 if(mousePosX < X_VEC_GUI[1]){
-                    run_step_frames_press_n(pauseSim, autoAdvanceSim);
+                    set_command(UI_CMD_STEP, 1, 'n');
                 } else if(mousePosX < X_VEC_GUI[2]){
-                    run_skip_frames(simState, autoAdvanceSim, 'a', AUTO_ADVANCE_DEFAULT);
+                    set_command(UI_CMD_SKIP, AUTO_ADVANCE_DEFAULT, 'a');
                 } else if(mousePosX < X_VEC_GUI[3]){
-                    simState = SIM_STATE_OPTIONS;
+                    set_command(UI_CMD_OPTIONS, 0, ' ');
                 }
             }
         }
         break;
         case SDL_QUIT:
+        set_command(UI_CMD_QUIT, 0, ' ');
+        break;
+    }
+    #undef set_command
+    return command;
+}
+
+void run_sim_state_step_frames(SDL_Event& windowEvent, bool& pauseSim, unsigned int& autoAdvanceSim, int& simState){
+    SDL_WaitEvent(&windowEvent);
+    UiCommand command = get_ui_command(windowEvent);
+    switch(command.type){
+        case UI_CMD_STEP:
+        run_step_frames_press_n(pauseSim, autoAdvanceSim);
+        break;
+        case UI_CMD_SKIP:
+        run_skip_frames(simState, autoAdvanceSim, command.key, command.numFrames);
+        break;
+        case UI_CMD_OPTIONS:
+        simState = SIM_STATE_OPTIONS;
+        break;
+        case UI_CMD_QUIT:
         simState = SIM_STATE_QUIT;
         pauseSim = false;
         break;
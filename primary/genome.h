@@ -0,0 +1,100 @@
+// The stats of a cell are kept in immutable, shared records. Cells with the same stats (e.g. a clone which
+//  did not mutate, or two cells of the same archetype) point to the same record instead of copying the map
+//  A record is only copied when a stat actually changes, and genomePool then merges identical records again
+#ifndef MAIN_INCLUDES_H
+#include "../mainIncludes/mainIncludes.h"
+#define MAIN_INCLUDES_H
+#endif
+
+
+// {{"stat1", {val, lb, ub, mutationPct1kChance, mutationMaxPct1kChange}}, ...}
+struct GenomeRecord {
+    std::map<std::string, std::vector<int>> stats;
+    uint64_t hash = 0; // Only set once the record is in genomePool
+
+    uint64_t calc_hash() const {
+        uint64_t ans = 14695981039346656037ULL; // The default start of hash_bytes(...)
+        for(auto& item : stats){
+            ans = hash_bytes(item.first.data(), item.first.size(), ans);
+            ans = hash_bytes(item.second.data(), item.second.size() * sizeof(int), ans);
+        }
+        return ans;
+    }
+};
+
+// Every record in use, at most once per distinct set of stats (i.e. hash-consed)
+//  NOTE: This is only used from the simulation thread
+struct GenomePool {
+    std::unordered_multimap<uint64_t, std::shared_ptr<GenomeRecord>> records;
+    int numRecordsAfterPrune = 0;
+
+    // Returns the pooled record with the same stats, adding pRecord if there isn't one
+    std::shared_ptr<GenomeRecord> intern(const std::shared_ptr<GenomeRecord>& pRecord){
+        uint64_t hash = pRecord->calc_hash();
+        auto range = records.equal_range(hash);
+        for(auto it = range.first; it != range.second; it++){
+            if(it->second->stats == pRecord->stats) return it->second;
+        }
+        if(records.size() >= 2 * numRecordsAfterPrune + 64) prune();
+        pRecord->hash = hash;
+        records.insert({hash, pRecord});
+        return pRecord;
+    }
+    // Forget the records which no cell uses anymore
+    void prune(){
+        for(auto it = records.begin(); it != records.end();){
+            if(it->second.use_count() == 1) it = records.erase(it);
+            else it++;
+        }
+        numRecordsAfterPrune = records.size();
+    }
+    int num_records(){ return records.size(); }
+};
+GenomePool genomePool;
+
+// A cell's handle to its stats. Reading works like the map it replaces (e.g. stats["dia"][0]),
+//  but every change has to go through set(...) or edit(...), which copy the record first if it is shared
+struct GenomeRef {
+    std::shared_ptr<GenomeRecord> pRecord;
+    bool isInterned = true; // Records in genomePool are shared, so they must never change
+
+    GenomeRef() : pRecord(get_empty_record()) {}
+    static const std::shared_ptr<GenomeRecord>& get_empty_record(){
+        static std::shared_ptr<GenomeRecord> pEmpty = std::make_shared<GenomeRecord>();
+        return pEmpty;
+    }
+
+    const std::vector<int>& operator[](const std::string& statName) const {
+        auto it = pRecord->stats.find(statName);
+        if(it == pRecord->stats.end()) std::cout << "Unknown stat: " << statName << std::endl;
+        assert(it != pRecord->stats.end());
+        return it->second;
+    }
+    size_t count(const std::string& statName) const { return pRecord->stats.count(statName); }
+    size_t size() const { return pRecord->stats.size(); }
+    std::map<std::string, std::vector<int>>::const_iterator begin() const { return pRecord->stats.begin(); }
+    std::map<std::string, std::vector<int>>::const_iterator end() const { return pRecord->stats.end(); }
+    bool operator==(const GenomeRef& other) const { return pRecord == other.pRecord || pRecord->stats == other.pRecord->stats; }
+
+    // Adds the stat if it does not exist yet
+    //  NOTE: This may replace the record, so hold a copy of pRecord while iterating over the stats and editing them
+    std::vector<int>& edit(const std::string& statName){
+        if(isInterned || pRecord.use_count() > 1){
+            pRecord = std::make_shared<GenomeRecord>(*pRecord);
+            pRecord->hash = 0;
+            isInterned = false;
+        }
+        return pRecord->stats[statName];
+    }
+    // Only copies the record if the value changes
+    void set(const std::string& statName, int i, int val){
+        if((*this)[statName][i] == val) return;
+        edit(statName)[i] = val;
+    }
+    // Share the record with every other cell that has the same stats
+    void intern(){
+        if(isInterned) return;
+        pRecord = genomePool.intern(pRecord);
+        isInterned = true;
+    }
+};
@@ -25,6 +25,50 @@ SDL_Texture* convArrToSDLTex(void* arr, int imgWidth, int imgHeight){
   return pTex;
 }
 
+// An image in texAtlas
+struct AtlasTex {
+  const unsigned char* pPixels; // RGBA, row by row
+  int width, height;
+  SDL_Rect srcRect; // Where the image is in texAtlas.pTexture
+};
+// The images in this file are small, so they are all packed into one texture, which is uploaded the
+//  first time one of them is drawn (i.e. once there is a renderer) instead of once per image at startup
+struct TexAtlas {
+  static const int WIDTH = 256; // Pixels
+  std::deque<AtlasTex> images; // A deque, so the pointers returned by add(...) stay valid
+  SDL_Texture* pTexture = NULL;
+  int rowX = 0, rowY = 0, rowHeight = 0; // The row being filled in
+
+  // Only decides where the image goes. The pixels are copied by get_texture()
+  AtlasTex* add(const unsigned char* pPixels, int width, int height){
+    assert(pTexture == NULL && width <= WIDTH);
+    if(rowX + width > WIDTH){
+      rowX = 0;
+      rowY += rowHeight + 1;
+      rowHeight = 0;
+    }
+    images.push_back({pPixels, width, height, {rowX, rowY, width, height}});
+    rowX += width + 1; // Images are 1 transparent pixel apart, so they do not bleed into each other when scaled
+    rowHeight = max_int(rowHeight, height);
+    return &images.back();
+  }
+  SDL_Texture* get_texture(){
+    if(pTexture != NULL) return pTexture;
+    const int NUM_CHANNELS = 4;
+    int height = rowY + rowHeight;
+    std::vector<unsigned char> pixels(NUM_CHANNELS * WIDTH * height, 0);
+    for(auto& image : images){
+      for(int y = 0; y < image.height; y++){
+        memcpy(&pixels[NUM_CHANNELS * ((image.srcRect.y + y) * WIDTH + image.srcRect.x)],
+          image.pPixels + NUM_CHANNELS * y * image.width, NUM_CHANNELS * image.width);
+      }
+    }
+    pTexture = convArrToSDLTex(pixels.data(), WIDTH, height);
+    return pTexture;
+  }
+};
+TexAtlas texAtlas;
+
 
 /////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////
@@ -59,9 +103,9 @@ SDL_Texture* convArrToSDLTex(void* arr, int imgWidth, int imgHeight){
 
 // Backgrounds
 unsigned char _blackBkgnd[] = { 0x00, 0x00, 0x00, 0xff };
-SDL_Texture* pBlackBkgnd = convArrToSDLTex(_blackBkgnd, 1, 1);
+AtlasTex* pBlackBkgnd = texAtlas.add(_blackBkgnd, 1, 1);
 unsigned char _whiteBkgnd[] = { 0xff, 0xff, 0xff, 0xff };
-SDL_Texture* pWhiteBkgnd = convArrToSDLTex(_whiteBkgnd, 1, 1);
+AtlasTex* pWhiteBkgnd = texAtlas.add(_whiteBkgnd, 1, 1);
 
 
 // Generic Textures I made
@@ -78,7 +122,7 @@ unsigned char _blackBkgndImg[] = {
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
 };
-SDL_Texture* pBlackBkgndTex = convArrToSDLTex(_blackBkgndImg, 10, 10);
+AtlasTex* pBlackBkgndTex = texAtlas.add(_blackBkgndImg, 10, 10);
 
 unsigned char _cellSkeletonImg[] = {
   _BLK, ___0, ___0, _BLK, _BLK, _BLK, _BLK, ___0, ___0, _BLK,
@@ -92,7 +136,7 @@ unsigned char _cellSkeletonImg[] = {
   ___0, _BLK, _BLK, _BLK, ___0, ___0, _BLK, _BLK, _BLK, ___0,
   _BLK, ___0, ___0, _BLK, _BLK, _BLK, _BLK, ___0, ___0, _BLK,
 };
-SDL_Texture* pCellSkeleton = convArrToSDLTex(_cellSkeletonImg, 10, 10);
+AtlasTex* pCellSkeleton = texAtlas.add(_cellSkeletonImg, 10, 10);
 
 // Black, dark red, light red, grey
 //  The Alpha value is lower here than for the opaque versions
@@ -112,7 +156,7 @@ unsigned char _deadCellImg[] = {
    ___0, _aBLK, _aBLK, _aBLK, aDRED, aDRED, _aBLK, _aBLK, _aBLK,  ___0,
   _aBLK,  ___0,  ___0, _aBLK, _aBLK, _aBLK, _aBLK,  ___0,  ___0, _aBLK,
 };
-SDL_Texture* pDeadCellTex = convArrToSDLTex(_deadCellImg, 10, 10);
+AtlasTex* pDeadCellTex = texAtlas.add(_deadCellImg, 10, 10);
 #undef _aBLK
 #undef aDRED
 #undef _aRED
@@ -136,7 +180,7 @@ unsigned char _doAttackImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pDoAttackTex = convArrToSDLTex(_doAttackImg, 10, 10);
+AtlasTex* pDoAttackTex = texAtlas.add(_doAttackImg, 10, 10);
 #undef RGBA
 
 #define RGBA 0xb8, 0x3d, 0xba, 0xff
@@ -152,7 +196,7 @@ unsigned char _doCloningImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pDoCloningTex = convArrToSDLTex(_doCloningImg, 10, 10);
+AtlasTex* pDoCloningTex = texAtlas.add(_doCloningImg, 10, 10);
 #undef RGBA
 
 
@@ -173,7 +217,7 @@ unsigned char _EAMBalancedImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEAMBalancedTex = convArrToSDLTex(_EAMBalancedImg, 10, 10);
+AtlasTex* pEAMBalancedTex = texAtlas.add(_EAMBalancedImg, 10, 10);
 unsigned char _EAMc1Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -186,7 +230,7 @@ unsigned char _EAMc1Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEAMc1Tex = convArrToSDLTex(_EAMc1Img, 10, 10);
+AtlasTex* pEAMc1Tex = texAtlas.add(_EAMc1Img, 10, 10);
 unsigned char _EAMc2Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -199,7 +243,7 @@ unsigned char _EAMc2Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEAMc2Tex = convArrToSDLTex(_EAMc2Img, 10, 10);
+AtlasTex* pEAMc2Tex = texAtlas.add(_EAMc2Img, 10, 10);
 unsigned char _EAMc3Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -212,7 +256,7 @@ unsigned char _EAMc3Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEAMc3Tex = convArrToSDLTex(_EAMc3Img, 10, 10);
+AtlasTex* pEAMc3Tex = texAtlas.add(_EAMc3Img, 10, 10);
 unsigned char _EAMc4Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -225,7 +269,7 @@ unsigned char _EAMc4Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEAMc4Tex = convArrToSDLTex(_EAMc4Img, 10, 10);
+AtlasTex* pEAMc4Tex = texAtlas.add(_EAMc4Img, 10, 10);
 unsigned char _EAMg4Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -238,7 +282,7 @@ unsigned char _EAMg4Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEAMg4Tex = convArrToSDLTex(_EAMg4Img, 10, 10);
+AtlasTex* pEAMg4Tex = texAtlas.add(_EAMg4Img, 10, 10);
 unsigned char _EAMs1Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -251,7 +295,7 @@ unsigned char _EAMs1Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEAMs1Tex = convArrToSDLTex(_EAMs1Img, 10, 10);
+AtlasTex* pEAMs1Tex = texAtlas.add(_EAMs1Img, 10, 10);
 unsigned char _EAMs2Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -264,7 +308,7 @@ unsigned char _EAMs2Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEAMs2Tex = convArrToSDLTex(_EAMs2Img, 10, 10);
+AtlasTex* pEAMs2Tex = texAtlas.add(_EAMs2Img, 10, 10);
 unsigned char _EAMs3Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -277,7 +321,7 @@ unsigned char _EAMs3Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEAMs3Tex = convArrToSDLTex(_EAMs3Img, 10, 10);
+AtlasTex* pEAMs3Tex = texAtlas.add(_EAMs3Img, 10, 10);
 unsigned char _EAMs4Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -290,7 +334,7 @@ unsigned char _EAMs4Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEAMs4Tex = convArrToSDLTex(_EAMs4Img, 10, 10);
+AtlasTex* pEAMs4Tex = texAtlas.add(_EAMs4Img, 10, 10);
 unsigned char _EAMg2c2Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -303,7 +347,7 @@ unsigned char _EAMg2c2Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEAMg2c2Tex = convArrToSDLTex(_EAMg2c2Img, 10, 10);
+AtlasTex* pEAMg2c2Tex = texAtlas.add(_EAMg2c2Img, 10, 10);
 unsigned char _EAMs2g2Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -316,7 +360,7 @@ unsigned char _EAMs2g2Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEAMs2g2Tex = convArrToSDLTex(_EAMs2g2Img, 10, 10);
+AtlasTex* pEAMs2g2Tex = texAtlas.add(_EAMs2g2Img, 10, 10);
 unsigned char _EAMs2c2Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -329,7 +373,7 @@ unsigned char _EAMs2c2Img[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEAMs2c2Tex = convArrToSDLTex(_EAMs2c2Img, 10, 10);
+AtlasTex* pEAMs2c2Tex = texAtlas.add(_EAMs2c2Img, 10, 10);
 
 
 /////////////////////////////////////////////////////////////////////////
@@ -349,7 +393,7 @@ unsigned char _energy0PctImg[] = {
   ___0, ___0, ___0, ___0, GREY, GREY, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy0PctTex = convArrToSDLTex(_energy0PctImg, 10, 10);
+AtlasTex* pEnergy0PctTex = texAtlas.add(_energy0PctImg, 10, 10);
 unsigned char _energy1PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, GREY, GREY, ___0, ___0, ___0, ___0,
@@ -362,7 +406,7 @@ unsigned char _energy1PctImg[] = {
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy1PctTex = convArrToSDLTex(_energy1PctImg, 10, 10);
+AtlasTex* pEnergy1PctTex = texAtlas.add(_energy1PctImg, 10, 10);
 unsigned char _energy2PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, GREY, GREY, ___0, ___0, ___0, ___0,
@@ -375,7 +419,7 @@ unsigned char _energy2PctImg[] = {
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy2PctTex = convArrToSDLTex(_energy2PctImg, 10, 10);
+AtlasTex* pEnergy2PctTex = texAtlas.add(_energy2PctImg, 10, 10);
 unsigned char _energy3PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, GREY, GREY, ___0, ___0, ___0, ___0,
@@ -388,7 +432,7 @@ unsigned char _energy3PctImg[] = {
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy3PctTex = convArrToSDLTex(_energy3PctImg, 10, 10);
+AtlasTex* pEnergy3PctTex = texAtlas.add(_energy3PctImg, 10, 10);
 unsigned char _energy4PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, GREY, GREY, ___0, ___0, ___0, ___0,
@@ -401,7 +445,7 @@ unsigned char _energy4PctImg[] = {
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy4PctTex = convArrToSDLTex(_energy4PctImg, 10, 10);
+AtlasTex* pEnergy4PctTex = texAtlas.add(_energy4PctImg, 10, 10);
 unsigned char _energy5PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, GREY, GREY, ___0, ___0, ___0, ___0,
@@ -414,7 +458,7 @@ unsigned char _energy5PctImg[] = {
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy5PctTex = convArrToSDLTex(_energy5PctImg, 10, 10);
+AtlasTex* pEnergy5PctTex = texAtlas.add(_energy5PctImg, 10, 10);
 unsigned char _energy6PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, GREY, GREY, ___0, ___0, ___0, ___0,
@@ -427,7 +471,7 @@ unsigned char _energy6PctImg[] = {
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy6PctTex = convArrToSDLTex(_energy6PctImg, 10, 10);
+AtlasTex* pEnergy6PctTex = texAtlas.add(_energy6PctImg, 10, 10);
 unsigned char _energy7PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, GREY, GREY, ___0, ___0, ___0, ___0,
@@ -440,7 +484,7 @@ unsigned char _energy7PctImg[] = {
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy7PctTex = convArrToSDLTex(_energy7PctImg, 10, 10);
+AtlasTex* pEnergy7PctTex = texAtlas.add(_energy7PctImg, 10, 10);
 unsigned char _energy8PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, GREY, GREY, ___0, ___0, ___0, ___0,
@@ -453,7 +497,7 @@ unsigned char _energy8PctImg[] = {
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy8PctTex = convArrToSDLTex(_energy8PctImg, 10, 10);
+AtlasTex* pEnergy8PctTex = texAtlas.add(_energy8PctImg, 10, 10);
 unsigned char _energy9PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, GREY, GREY, ___0, ___0, ___0, ___0,
@@ -466,7 +510,7 @@ unsigned char _energy9PctImg[] = {
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy9PctTex = convArrToSDLTex(_energy9PctImg, 10, 10);
+AtlasTex* pEnergy9PctTex = texAtlas.add(_energy9PctImg, 10, 10);
 unsigned char _energy10PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
@@ -479,7 +523,7 @@ unsigned char _energy10PctImg[] = {
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy10PctTex = convArrToSDLTex(_energy10PctImg, 10, 10);
+AtlasTex* pEnergy10PctTex = texAtlas.add(_energy10PctImg, 10, 10);
 unsigned char _energy20PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
@@ -492,7 +536,7 @@ unsigned char _energy20PctImg[] = {
   ___0, ___0, ___0, ___0, _GRN, _GRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy20PctTex = convArrToSDLTex(_energy20PctImg, 10, 10);
+AtlasTex* pEnergy20PctTex = texAtlas.add(_energy20PctImg, 10, 10);
 unsigned char _energy30PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
@@ -505,7 +549,7 @@ unsigned char _energy30PctImg[] = {
   ___0, ___0, ___0, ___0, _GRN, _GRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy30PctTex = convArrToSDLTex(_energy30PctImg, 10, 10);
+AtlasTex* pEnergy30PctTex = texAtlas.add(_energy30PctImg, 10, 10);
 unsigned char _energy40PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
@@ -518,7 +562,7 @@ unsigned char _energy40PctImg[] = {
   ___0, ___0, ___0, ___0, _GRN, _GRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy40PctTex = convArrToSDLTex(_energy40PctImg, 10, 10);
+AtlasTex* pEnergy40PctTex = texAtlas.add(_energy40PctImg, 10, 10);
 unsigned char _energy50PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
@@ -531,7 +575,7 @@ unsigned char _energy50PctImg[] = {
   ___0, ___0, ___0, ___0, _GRN, _GRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy50PctTex = convArrToSDLTex(_energy50PctImg, 10, 10);
+AtlasTex* pEnergy50PctTex = texAtlas.add(_energy50PctImg, 10, 10);
 unsigned char _energy60PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
@@ -544,7 +588,7 @@ unsigned char _energy60PctImg[] = {
   ___0, ___0, ___0, ___0, _GRN, _GRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy60PctTex = convArrToSDLTex(_energy60PctImg, 10, 10);
+AtlasTex* pEnergy60PctTex = texAtlas.add(_energy60PctImg, 10, 10);
 unsigned char _energy70PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
@@ -557,7 +601,7 @@ unsigned char _energy70PctImg[] = {
   ___0, ___0, ___0, ___0, _GRN, _GRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy70PctTex = convArrToSDLTex(_energy70PctImg, 10, 10);
+AtlasTex* pEnergy70PctTex = texAtlas.add(_energy70PctImg, 10, 10);
 unsigned char _energy80PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
@@ -570,7 +614,7 @@ unsigned char _energy80PctImg[] = {
   ___0, ___0, ___0, ___0, _GRN, _GRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy80PctTex = convArrToSDLTex(_energy80PctImg, 10, 10);
+AtlasTex* pEnergy80PctTex = texAtlas.add(_energy80PctImg, 10, 10);
 unsigned char _energy90PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, DGRN, DGRN, ___0, ___0, ___0, ___0,
@@ -583,7 +627,7 @@ unsigned char _energy90PctImg[] = {
   ___0, ___0, ___0, ___0, _GRN, _GRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy90PctTex = convArrToSDLTex(_energy90PctImg, 10, 10);
+AtlasTex* pEnergy90PctTex = texAtlas.add(_energy90PctImg, 10, 10);
 unsigned char _energy100PctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, _GRN, _GRN, ___0, ___0, ___0, ___0,
@@ -596,7 +640,7 @@ unsigned char _energy100PctImg[] = {
   ___0, ___0, ___0, ___0, _GRN, _GRN, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pEnergy100PctTex = convArrToSDLTex(_energy100PctImg, 10, 10);
+AtlasTex* pEnergy100PctTex = texAtlas.add(_energy100PctImg, 10, 10);
 
 
 /////////////////////////////////////////////////////////////////////////
@@ -626,7 +670,7 @@ unsigned char _energyGnd0pctImg[] = {
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
 };
-SDL_Texture* pEnergyGnd0pctTex = convArrToSDLTex(_energyGnd0pctImg, 20, 20);
+AtlasTex* pEnergyGnd0pctTex = texAtlas.add(_energyGnd0pctImg, 20, 20);
 unsigned char _energyGnd10pctImg[] = {
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
@@ -649,7 +693,7 @@ unsigned char _energyGnd10pctImg[] = {
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
 };
-SDL_Texture* pEnergyGnd10pctTex = convArrToSDLTex(_energyGnd10pctImg, 20, 20);
+AtlasTex* pEnergyGnd10pctTex = texAtlas.add(_energyGnd10pctImg, 20, 20);
 unsigned char _energyGnd20pctImg[] = {
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
@@ -672,7 +716,7 @@ unsigned char _energyGnd20pctImg[] = {
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
 };
-SDL_Texture* pEnergyGnd20pctTex = convArrToSDLTex(_energyGnd20pctImg, 20, 20);
+AtlasTex* pEnergyGnd20pctTex = texAtlas.add(_energyGnd20pctImg, 20, 20);
 unsigned char _energyGnd30pctImg[] = {
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
@@ -695,7 +739,7 @@ unsigned char _energyGnd30pctImg[] = {
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
 };
-SDL_Texture* pEnergyGnd30pctTex = convArrToSDLTex(_energyGnd30pctImg, 20, 20);
+AtlasTex* pEnergyGnd30pctTex = texAtlas.add(_energyGnd30pctImg, 20, 20);
 unsigned char _energyGnd40pctImg[] = {
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
@@ -718,7 +762,7 @@ unsigned char _energyGnd40pctImg[] = {
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
 };
-SDL_Texture* pEnergyGnd40pctTex = convArrToSDLTex(_energyGnd40pctImg, 20, 20);
+AtlasTex* pEnergyGnd40pctTex = texAtlas.add(_energyGnd40pctImg, 20, 20);
 unsigned char _energyGnd50pctImg[] = {
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
@@ -741,7 +785,7 @@ unsigned char _energyGnd50pctImg[] = {
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
 };
-SDL_Texture* pEnergyGnd50pctTex = convArrToSDLTex(_energyGnd50pctImg, 20, 20);
+AtlasTex* pEnergyGnd50pctTex = texAtlas.add(_energyGnd50pctImg, 20, 20);
 unsigned char _energyGnd60pctImg[] = {
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
@@ -764,7 +808,7 @@ unsigned char _energyGnd60pctImg[] = {
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
 };
-SDL_Texture* pEnergyGnd60pctTex = convArrToSDLTex(_energyGnd60pctImg, 20, 20);
+AtlasTex* pEnergyGnd60pctTex = texAtlas.add(_energyGnd60pctImg, 20, 20);
 unsigned char _energyGnd70pctImg[] = {
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
@@ -787,7 +831,7 @@ unsigned char _energyGnd70pctImg[] = {
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
 };
-SDL_Texture* pEnergyGnd70pctTex = convArrToSDLTex(_energyGnd70pctImg, 20, 20);
+AtlasTex* pEnergyGnd70pctTex = texAtlas.add(_energyGnd70pctImg, 20, 20);
 unsigned char _energyGnd80pctImg[] = {
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
@@ -810,7 +854,7 @@ unsigned char _energyGnd80pctImg[] = {
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
 };
-SDL_Texture* pEnergyGnd80pctTex = convArrToSDLTex(_energyGnd80pctImg, 20, 20);
+AtlasTex* pEnergyGnd80pctTex = texAtlas.add(_energyGnd80pctImg, 20, 20);
 unsigned char _energyGnd90pctImg[] = {
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
@@ -833,7 +877,7 @@ unsigned char _energyGnd90pctImg[] = {
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
 };
-SDL_Texture* pEnergyGnd90pctTex = convArrToSDLTex(_energyGnd90pctImg, 20, 20);
+AtlasTex* pEnergyGnd90pctTex = texAtlas.add(_energyGnd90pctImg, 20, 20);
 unsigned char _energyGnd100pctImg[] = {
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
@@ -856,7 +900,7 @@ unsigned char _energyGnd100pctImg[] = {
   _BLK, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, _BLK,
   _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK, _BLK,
 };
-SDL_Texture* pEnergyGnd100pctTex = convArrToSDLTex(_energyGnd100pctImg, 20, 20);
+AtlasTex* pEnergyGnd100pctTex = texAtlas.add(_energyGnd100pctImg, 20, 20);
 
 
 /////////////////////////////////////////////////////////////////////////
@@ -876,7 +920,7 @@ unsigned char _health0pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pHealth0pctTex = convArrToSDLTex(_health0pctImg, 10, 10);
+AtlasTex* pHealth0pctTex = texAtlas.add(_health0pctImg, 10, 10);
 unsigned char _health10pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -889,7 +933,7 @@ unsigned char _health10pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pHealth10pctTex = convArrToSDLTex(_health10pctImg, 10, 10);
+AtlasTex* pHealth10pctTex = texAtlas.add(_health10pctImg, 10, 10);
 unsigned char _health20pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -902,7 +946,7 @@ unsigned char _health20pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pHealth20pctTex = convArrToSDLTex(_health20pctImg, 10, 10);
+AtlasTex* pHealth20pctTex = texAtlas.add(_health20pctImg, 10, 10);
 unsigned char _health30pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -915,7 +959,7 @@ unsigned char _health30pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pHealth30pctTex = convArrToSDLTex(_health30pctImg, 10, 10);
+AtlasTex* pHealth30pctTex = texAtlas.add(_health30pctImg, 10, 10);
 unsigned char _health40pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -928,7 +972,7 @@ unsigned char _health40pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pHealth40pctTex = convArrToSDLTex(_health40pctImg, 10, 10);
+AtlasTex* pHealth40pctTex = texAtlas.add(_health40pctImg, 10, 10);
 unsigned char _health50pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -941,7 +985,7 @@ unsigned char _health50pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pHealth50pctTex = convArrToSDLTex(_health50pctImg, 10, 10);
+AtlasTex* pHealth50pctTex = texAtlas.add(_health50pctImg, 10, 10);
 unsigned char _health60pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -954,7 +998,7 @@ unsigned char _health60pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pHealth60pctTex = convArrToSDLTex(_health60pctImg, 10, 10);
+AtlasTex* pHealth60pctTex = texAtlas.add(_health60pctImg, 10, 10);
 unsigned char _health70pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -967,7 +1011,7 @@ unsigned char _health70pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pHealth70pctTex = convArrToSDLTex(_health70pctImg, 10, 10);
+AtlasTex* pHealth70pctTex = texAtlas.add(_health70pctImg, 10, 10);
 unsigned char _health80pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -980,7 +1024,7 @@ unsigned char _health80pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pHealth80pctTex = convArrToSDLTex(_health80pctImg, 10, 10);
+AtlasTex* pHealth80pctTex = texAtlas.add(_health80pctImg, 10, 10);
 unsigned char _health90pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -993,7 +1037,7 @@ unsigned char _health90pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pHealth90pctTex = convArrToSDLTex(_health90pctImg, 10, 10);
+AtlasTex* pHealth90pctTex = texAtlas.add(_health90pctImg, 10, 10);
 unsigned char _health100pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
@@ -1006,7 +1050,7 @@ unsigned char _health100pctImg[] = {
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
   ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0, ___0,
 };
-SDL_Texture* pHealth100pctTex = convArrToSDLTex(_health100pctImg, 10, 10);
+AtlasTex* pHealth100pctTex = texAtlas.add(_health100pctImg, 10, 10);
 
 /////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////
@@ -1056,7 +1100,7 @@ unsigned char _0_Symbol[] = {
   _,_,X,X,X,X,X,X,X,X,X,X,X,_,_,
   _,_,_,_,X,X,X,X,X,X,X,_,_,_,_,
 };
-SDL_Texture* p_0_Symbol = convArrToSDLTex(_0_Symbol, 15, 32);
+AtlasTex* p_0_Symbol = texAtlas.add(_0_Symbol, 15, 32);
 unsigned char _1_Symbol[] = {
   _,_,_,_,_,_,X,X,X,_,_,_,_,_,_,
   _,_,_,_,_,X,X,X,X,_,_,_,_,_,_,
@@ -1091,7 +1135,7 @@ unsigned char _1_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
 };
-SDL_Texture* p_1_Symbol = convArrToSDLTex(_1_Symbol, 15, 32);
+AtlasTex* p_1_Symbol = texAtlas.add(_1_Symbol, 15, 32);
 unsigned char _2_Symbol[] = {
   _,_,_,X,X,X,X,X,X,X,X,X,_,_,_,
   _,_,X,X,X,X,X,X,X,X,X,X,X,_,_,
@@ -1126,7 +1170,7 @@ unsigned char _2_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
 };
-SDL_Texture* p_2_Symbol = convArrToSDLTex(_2_Symbol, 15, 32);
+AtlasTex* p_2_Symbol = texAtlas.add(_2_Symbol, 15, 32);
 unsigned char _3_Symbol[] = {
   _,_,_,X,X,X,X,X,X,X,X,_,_,_,_,
   _,_,X,X,X,X,X,X,X,X,X,X,X,_,_,
@@ -1161,7 +1205,7 @@ unsigned char _3_Symbol[] = {
   _,_,X,X,X,X,X,X,X,X,X,X,X,_,_,
   _,_,_,X,X,X,X,X,X,X,X,_,_,_,_,
 };
-SDL_Texture* p_3_Symbol = convArrToSDLTex(_3_Symbol, 15, 32);
+AtlasTex* p_3_Symbol = texAtlas.add(_3_Symbol, 15, 32);
 unsigned char _4_Symbol[] = {
   X,X,X,_,_,_,_,_,_,_,X,X,X,_,_,
   X,X,X,_,_,_,_,_,_,_,X,X,X,_,_,
@@ -1196,7 +1240,7 @@ unsigned char _4_Symbol[] = {
   _,_,_,_,_,_,_,_,_,_,X,X,X,_,_,
   _,_,_,_,_,_,_,_,_,_,X,X,X,_,_,
 };
-SDL_Texture* p_4_Symbol = convArrToSDLTex(_4_Symbol, 15, 32);
+AtlasTex* p_4_Symbol = texAtlas.add(_4_Symbol, 15, 32);
 unsigned char _5_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
@@ -1231,7 +1275,7 @@ unsigned char _5_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
 };
-SDL_Texture* p_5_Symbol = convArrToSDLTex(_5_Symbol, 15, 32);
+AtlasTex* p_5_Symbol = texAtlas.add(_5_Symbol, 15, 32);
 unsigned char _6_Symbol[] = {
   _,_,X,X,X,X,X,X,X,X,X,X,X,X,_,
   _,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
@@ -1266,7 +1310,7 @@ unsigned char _6_Symbol[] = {
   _,X,X,X,X,X,X,X,X,X,X,X,X,X,_,
   _,_,X,X,X,X,X,X,X,X,X,X,X,_,_,
 };
-SDL_Texture* p_6_Symbol = convArrToSDLTex(_6_Symbol, 15, 32);
+AtlasTex* p_6_Symbol = texAtlas.add(_6_Symbol, 15, 32);
 unsigned char _7_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
@@ -1301,7 +1345,7 @@ unsigned char _7_Symbol[] = {
   X,X,X,_,_,_,_,_,_,_,_,_,_,_,_,
   X,X,X,_,_,_,_,_,_,_,_,_,_,_,_,
 };
-SDL_Texture* p_7_Symbol = convArrToSDLTex(_7_Symbol, 15, 32);
+AtlasTex* p_7_Symbol = texAtlas.add(_7_Symbol, 15, 32);
 unsigned char _8_Symbol[] = {
   _,_,X,X,X,X,X,X,X,X,X,X,X,_,_,
   _,X,X,X,X,X,X,X,X,X,X,X,X,X,_,
@@ -1336,7 +1380,7 @@ unsigned char _8_Symbol[] = {
   _,X,X,X,X,X,X,X,X,X,X,X,X,X,_,
   _,_,X,X,X,X,X,X,X,X,X,X,X,_,_,
 };
-SDL_Texture* p_8_Symbol = convArrToSDLTex(_8_Symbol, 15, 32);
+AtlasTex* p_8_Symbol = texAtlas.add(_8_Symbol, 15, 32);
 unsigned char _9_Symbol[] = {
   _,_,X,X,X,X,X,X,X,X,X,X,X,_,_,
   _,X,X,X,X,X,X,X,X,X,X,X,X,X,_,
@@ -1371,7 +1415,7 @@ unsigned char _9_Symbol[] = {
   _,X,X,X,X,X,X,X,X,X,X,X,X,X,_,
   _,_,X,X,X,X,X,X,X,X,X,X,X,_,_,
 };
-SDL_Texture* p_9_Symbol = convArrToSDLTex(_9_Symbol, 15, 32);
+AtlasTex* p_9_Symbol = texAtlas.add(_9_Symbol, 15, 32);
 
 
 
@@ -1418,7 +1462,7 @@ unsigned char _A_Symbol[] = {
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
 };
-SDL_Texture* p_A_Symbol = convArrToSDLTex(_A_Symbol, 15, 32);
+AtlasTex* p_A_Symbol = texAtlas.add(_A_Symbol, 15, 32);
 unsigned char _B_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,_,_,_,_,
   X,X,X,X,X,X,X,X,X,X,X,X,_,_,_,
@@ -1453,7 +1497,7 @@ unsigned char _B_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,X,_,_,_,
   X,X,X,X,X,X,X,X,X,X,X,_,_,_,_,
 };
-SDL_Texture* p_B_Symbol = convArrToSDLTex(_B_Symbol, 15, 32);
+AtlasTex* p_B_Symbol = texAtlas.add(_B_Symbol, 15, 32);
 unsigned char _C_Symbol[] = {
   _,_,_,X,X,X,X,X,X,X,X,X,_,_,_,
   _,_,X,X,X,X,X,X,X,X,X,X,X,X,_,
@@ -1488,7 +1532,7 @@ unsigned char _C_Symbol[] = {
   _,_,X,X,X,X,X,X,X,X,X,X,X,X,_,
   _,_,_,X,X,X,X,X,X,X,X,X,_,_,_,
 };
-SDL_Texture* p_C_Symbol = convArrToSDLTex(_C_Symbol, 15, 32);
+AtlasTex* p_C_Symbol = texAtlas.add(_C_Symbol, 15, 32);
 unsigned char _D_Symbol[] = {
   X,X,X,X,X,X,X,X,_,_,_,_,_,_,_,
   X,X,X,X,X,X,X,X,X,X,_,_,_,_,_,
@@ -1523,7 +1567,7 @@ unsigned char _D_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,_,_,_,_,_,
   X,X,X,X,X,X,X,X,_,_,_,_,_,_,_,
 };
-SDL_Texture* p_D_Symbol = convArrToSDLTex(_D_Symbol, 15, 32);
+AtlasTex* p_D_Symbol = texAtlas.add(_D_Symbol, 15, 32);
 unsigned char _E_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
@@ -1558,7 +1602,7 @@ unsigned char _E_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
 };
-SDL_Texture* p_E_Symbol = convArrToSDLTex(_E_Symbol, 15, 32);
+AtlasTex* p_E_Symbol = texAtlas.add(_E_Symbol, 15, 32);
 unsigned char _F_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
@@ -1593,7 +1637,7 @@ unsigned char _F_Symbol[] = {
   X,X,X,_,_,_,_,_,_,_,_,_,_,_,_,
   X,X,X,_,_,_,_,_,_,_,_,_,_,_,_,
 };
-SDL_Texture* p_F_Symbol = convArrToSDLTex(_F_Symbol, 15, 32);
+AtlasTex* p_F_Symbol = texAtlas.add(_F_Symbol, 15, 32);
 unsigned char _G_Symbol[] = {
   _,_,_,X,X,X,X,X,X,X,X,X,_,_,_,
   _,_,X,X,X,X,X,X,X,X,X,X,X,X,_,
@@ -1628,7 +1672,7 @@ unsigned char _G_Symbol[] = {
   _,_,X,X,X,X,X,X,X,X,X,X,X,X,_,
   _,_,_,X,X,X,X,X,X,X,X,X,_,_,_,
 };
-SDL_Texture* p_G_Symbol = convArrToSDLTex(_G_Symbol, 15, 32);
+AtlasTex* p_G_Symbol = texAtlas.add(_G_Symbol, 15, 32);
 unsigned char _H_Symbol[] = {
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
@@ -1663,7 +1707,7 @@ unsigned char _H_Symbol[] = {
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
 };
-SDL_Texture* p_H_Symbol = convArrToSDLTex(_H_Symbol, 15, 32);
+AtlasTex* p_H_Symbol = texAtlas.add(_H_Symbol, 15, 32);
 unsigned char _I_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
@@ -1698,7 +1742,7 @@ unsigned char _I_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
 };
-SDL_Texture* p_I_Symbol = convArrToSDLTex(_I_Symbol, 15, 32);
+AtlasTex* p_I_Symbol = texAtlas.add(_I_Symbol, 15, 32);
 unsigned char _J_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
@@ -1733,7 +1777,7 @@ unsigned char _J_Symbol[] = {
   _,X,X,X,X,X,X,_,_,_,_,_,_,_,_,
   _,_,X,X,X,X,_,_,_,_,_,_,_,_,_,
 };
-SDL_Texture* p_J_Symbol = convArrToSDLTex(_J_Symbol, 15, 32);
+AtlasTex* p_J_Symbol = texAtlas.add(_J_Symbol, 15, 32);
 unsigned char _K_Symbol[] = {
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
   X,X,X,_,_,_,_,_,_,_,_,X,X,X,X,
@@ -1768,7 +1812,7 @@ unsigned char _K_Symbol[] = {
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
 };
-SDL_Texture* p_K_Symbol = convArrToSDLTex(_K_Symbol, 15, 32);
+AtlasTex* p_K_Symbol = texAtlas.add(_K_Symbol, 15, 32);
 unsigned char _L_Symbol[] = {
   X,X,X,_,_,_,_,_,_,_,_,_,_,_,_,
   X,X,X,_,_,_,_,_,_,_,_,_,_,_,_,
@@ -1803,7 +1847,7 @@ unsigned char _L_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
 };
-SDL_Texture* p_L_Symbol = convArrToSDLTex(_L_Symbol, 15, 32);
+AtlasTex* p_L_Symbol = texAtlas.add(_L_Symbol, 15, 32);
 unsigned char _M_Symbol[] = {
   X,X,X,X,_,_,_,_,_,_,_,X,X,X,X,
   X,X,X,X,_,_,_,_,_,_,_,X,X,X,X,
@@ -1838,7 +1882,7 @@ unsigned char _M_Symbol[] = {
   X,X,X,_,_,_,X,X,X,_,_,_,X,X,X,
   X,X,X,_,_,_,X,X,X,_,_,_,X,X,X,
 };
-SDL_Texture* p_M_Symbol = convArrToSDLTex(_M_Symbol, 15, 32);
+AtlasTex* p_M_Symbol = texAtlas.add(_M_Symbol, 15, 32);
 unsigned char _N_Symbol[] = {
   X,X,X,X,_,_,_,_,_,_,_,_,X,X,X,
   X,X,X,X,_,_,_,_,_,_,_,_,X,X,X,
@@ -1873,7 +1917,7 @@ unsigned char _N_Symbol[] = {
   X,X,X,_,_,_,_,_,_,_,_,X,X,X,X,
   X,X,X,_,_,_,_,_,_,_,_,X,X,X,X,
 };
-SDL_Texture* p_N_Symbol = convArrToSDLTex(_N_Symbol, 15, 32);
+AtlasTex* p_N_Symbol = texAtlas.add(_N_Symbol, 15, 32);
 unsigned char _O_Symbol[] = {
   _,_,_,_,X,X,X,X,X,X,X,_,_,_,_,
   _,_,X,X,X,X,X,X,X,X,X,X,X,_,_,
@@ -1908,7 +1952,7 @@ unsigned char _O_Symbol[] = {
   _,_,X,X,X,X,X,X,X,X,X,X,X,_,_,
   _,_,_,_,X,X,X,X,X,X,X,_,_,_,_,
 };
-SDL_Texture* p_O_Symbol = convArrToSDLTex(_O_Symbol, 15, 32);
+AtlasTex* p_O_Symbol = texAtlas.add(_O_Symbol, 15, 32);
 unsigned char _P_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,_,_,_,_,
   X,X,X,X,X,X,X,X,X,X,X,X,_,_,_,
@@ -1943,7 +1987,7 @@ unsigned char _P_Symbol[] = {
   X,X,X,_,_,_,_,_,_,_,_,_,_,_,_,
   X,X,X,_,_,_,_,_,_,_,_,_,_,_,_,
 };
-SDL_Texture* p_P_Symbol = convArrToSDLTex(_P_Symbol, 15, 32);
+AtlasTex* p_P_Symbol = texAtlas.add(_P_Symbol, 15, 32);
 unsigned char _Q_Symbol[] = {
   _,_,_,_,X,X,X,X,X,X,X,_,_,_,_,
   _,_,X,X,X,X,X,X,X,X,X,X,X,_,_,
@@ -1978,7 +2022,7 @@ unsigned char _Q_Symbol[] = {
   _,_,X,X,X,X,X,X,X,X,X,X,X,X,X,
   _,_,_,_,X,X,X,X,X,X,X,_,_,X,X,
 };
-SDL_Texture* p_Q_Symbol = convArrToSDLTex(_Q_Symbol, 15, 32);
+AtlasTex* p_Q_Symbol = texAtlas.add(_Q_Symbol, 15, 32);
 unsigned char _R_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,_,_,_,_,_,
   X,X,X,X,X,X,X,X,X,X,X,X,_,_,_,
@@ -2013,7 +2057,7 @@ unsigned char _R_Symbol[] = {
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
 };
-SDL_Texture* p_R_Symbol = convArrToSDLTex(_R_Symbol, 15, 32);
+AtlasTex* p_R_Symbol = texAtlas.add(_R_Symbol, 15, 32);
 unsigned char _S_Symbol[] = {
   _,_,_,_,X,X,X,X,X,X,X,X,_,_,_,
   _,_,_,X,X,X,X,X,X,X,X,X,X,_,_,
@@ -2048,7 +2092,7 @@ unsigned char _S_Symbol[] = {
   _,_,X,X,X,X,X,X,X,X,X,X,X,_,_,
   _,_,_,_,X,X,X,X,X,X,X,_,_,_,_,
 };
-SDL_Texture* p_S_Symbol = convArrToSDLTex(_S_Symbol, 15, 32);
+AtlasTex* p_S_Symbol = texAtlas.add(_S_Symbol, 15, 32);
 unsigned char _T_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
@@ -2083,7 +2127,7 @@ unsigned char _T_Symbol[] = {
   _,_,_,_,_,_,X,X,X,_,_,_,_,_,_,
   _,_,_,_,_,_,X,X,X,_,_,_,_,_,_,
 };
-SDL_Texture* p_T_Symbol = convArrToSDLTex(_T_Symbol, 15, 32);
+AtlasTex* p_T_Symbol = texAtlas.add(_T_Symbol, 15, 32);
 unsigned char _U_Symbol[] = {
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
@@ -2118,7 +2162,7 @@ unsigned char _U_Symbol[] = {
   _,_,X,X,X,X,X,X,X,X,X,X,X,_,_,
   _,_,_,_,X,X,X,X,X,X,X,_,_,_,_,
 };
-SDL_Texture* p_U_Symbol = convArrToSDLTex(_U_Symbol, 15, 32);
+AtlasTex* p_U_Symbol = texAtlas.add(_U_Symbol, 15, 32);
 unsigned char _V_Symbol[] = {
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
@@ -2153,7 +2197,7 @@ unsigned char _V_Symbol[] = {
   _,_,_,_,_,_,X,X,X,_,_,_,_,_,_,
   _,_,_,_,_,_,X,X,X,_,_,_,_,_,_,
 };
-SDL_Texture* p_V_Symbol = convArrToSDLTex(_V_Symbol, 15, 32);
+AtlasTex* p_V_Symbol = texAtlas.add(_V_Symbol, 15, 32);
 unsigned char _W_Symbol[] = {
   X,X,X,_,_,_,X,X,X,_,_,_,X,X,X,
   X,X,X,_,_,_,X,X,X,_,_,_,X,X,X,
@@ -2188,7 +2232,7 @@ unsigned char _W_Symbol[] = {
   X,X,X,X,_,_,_,_,_,_,_,X,X,X,X,
   X,X,X,X,_,_,_,_,_,_,_,X,X,X,X,
 };
-SDL_Texture* p_W_Symbol = convArrToSDLTex(_W_Symbol, 15, 32);
+AtlasTex* p_W_Symbol = texAtlas.add(_W_Symbol, 15, 32);
 unsigned char _X_Symbol[] = {
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
@@ -2223,7 +2267,7 @@ unsigned char _X_Symbol[] = {
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
 };
-SDL_Texture* p_X_Symbol = convArrToSDLTex(_X_Symbol, 15, 32);
+AtlasTex* p_X_Symbol = texAtlas.add(_X_Symbol, 15, 32);
 unsigned char _Y_Symbol[] = {
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
   X,X,X,_,_,_,_,_,_,_,_,_,X,X,X,
@@ -2258,7 +2302,7 @@ unsigned char _Y_Symbol[] = {
   _,_,_,_,_,_,X,X,X,_,_,_,_,_,_,
   _,_,_,_,_,_,X,X,X,_,_,_,_,_,_,
 };
-SDL_Texture* p_Y_Symbol = convArrToSDLTex(_Y_Symbol, 15, 32);
+AtlasTex* p_Y_Symbol = texAtlas.add(_Y_Symbol, 15, 32);
 unsigned char _Z_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
@@ -2293,7 +2337,7 @@ unsigned char _Z_Symbol[] = {
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
   X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
 };
-SDL_Texture* p_Z_Symbol = convArrToSDLTex(_Z_Symbol, 15, 32);
+AtlasTex* p_Z_Symbol = texAtlas.add(_Z_Symbol, 15, 32);
 
 
 
@@ -2339,7 +2383,7 @@ unsigned char _spaceSymbol[] = {
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
 };
-SDL_Texture* pSpaceSymbol = convArrToSDLTex(_spaceSymbol, 15, 32);
+AtlasTex* pSpaceSymbol = texAtlas.add(_spaceSymbol, 15, 32);
 unsigned char _minusSymbol[] = {
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
@@ -2374,7 +2418,7 @@ unsigned char _minusSymbol[] = {
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
 };
-SDL_Texture* pMinusSymbol = convArrToSDLTex(_minusSymbol, 15, 32);
+AtlasTex* pMinusSymbol = texAtlas.add(_minusSymbol, 15, 32);
 unsigned char _plusSymbol[] = {
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
@@ -2409,7 +2453,7 @@ unsigned char _plusSymbol[] = {
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
 };
-SDL_Texture* pPlusSymbol = convArrToSDLTex(_plusSymbol, 15, 32);
+AtlasTex* pPlusSymbol = texAtlas.add(_plusSymbol, 15, 32);
 unsigned char _dashSymbol[] = {
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
@@ -2444,7 +2488,7 @@ unsigned char _dashSymbol[] = {
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
 };
-SDL_Texture* pDashSymbol = convArrToSDLTex(_dashSymbol, 15, 32);
+AtlasTex* pDashSymbol = texAtlas.add(_dashSymbol, 15, 32);
 unsigned char _equalSymbol[] = {
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
@@ -2479,7 +2523,7 @@ unsigned char _equalSymbol[] = {
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
 };
-SDL_Texture* pEqualSymbol = convArrToSDLTex(_equalSymbol, 15, 32);
+AtlasTex* pEqualSymbol = texAtlas.add(_equalSymbol, 15, 32);
 
 unsigned char _leftSquareBracket[] = {
   X,X,X,X,X,X,X,X,X,X,X,_,_,_,_,
@@ -2515,7 +2559,7 @@ unsigned char _leftSquareBracket[] = {
   X,X,X,X,X,X,X,X,X,X,X,_,_,_,_,
   X,X,X,X,X,X,X,X,X,X,X,_,_,_,_,
 };
-SDL_Texture* pLeftSquareBracketSymbol = convArrToSDLTex(_leftSquareBracket, 15, 32);
+AtlasTex* pLeftSquareBracketSymbol = texAtlas.add(_leftSquareBracket, 15, 32);
 unsigned char _rightSquareBracket[] = {
   _,_,_,_,X,X,X,X,X,X,X,X,X,X,X,
   _,_,_,_,X,X,X,X,X,X,X,X,X,X,X,
@@ -2550,7 +2594,7 @@ unsigned char _rightSquareBracket[] = {
   _,_,_,_,X,X,X,X,X,X,X,X,X,X,X,
   _,_,_,_,X,X,X,X,X,X,X,X,X,X,X,
 };
-SDL_Texture* pRightSquareBracketSymbol = convArrToSDLTex(_rightSquareBracket, 15, 32);
+AtlasTex* pRightSquareBracketSymbol = texAtlas.add(_rightSquareBracket, 15, 32);
 unsigned char _colonSymbol[] = {
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
@@ -2585,7 +2629,7 @@ unsigned char _colonSymbol[] = {
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
 };
-SDL_Texture* pColonSymbol = convArrToSDLTex(_colonSymbol, 15, 32);
+AtlasTex* pColonSymbol = texAtlas.add(_colonSymbol, 15, 32);
 unsigned char _hashtagSymbol[] = {
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
@@ -2620,7 +2664,7 @@ unsigned char _hashtagSymbol[] = {
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
 };
-SDL_Texture* pHashtagSymbol = convArrToSDLTex(_hashtagSymbol, 15, 32);
+AtlasTex* pHashtagSymbol = texAtlas.add(_hashtagSymbol, 15, 32);
 unsigned char _periodSymbol[] = {
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
@@ -2655,7 +2699,7 @@ unsigned char _periodSymbol[] = {
   _,_,_,_,_,X,X,X,X,X,_,_,_,_,_,
   _,_,_,_,_,_,X,X,X,_,_,_,_,_,_,
 };
-SDL_Texture* pPeriodSymbol = convArrToSDLTex(_periodSymbol, 15, 32);
+AtlasTex* pPeriodSymbol = texAtlas.add(_periodSymbol, 15, 32);
 unsigned char _commaSymbol[] = {
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
@@ -2690,7 +2734,7 @@ unsigned char _commaSymbol[] = {
   X,X,_,_,_,_,_,_,_,_,_,_,_,_,_,
   X,X,_,_,_,_,_,_,_,_,_,_,_,_,_,
 };
-SDL_Texture* pCommaSymbol = convArrToSDLTex(_commaSymbol, 15, 32);
+AtlasTex* pCommaSymbol = texAtlas.add(_commaSymbol, 15, 32);
 unsigned char _exclamationMarkSymbol[] = {
   _,_,_,_,_,_,X,X,X,_,_,_,_,_,_,
   _,_,_,_,_,X,X,X,X,X,_,_,_,_,_,
@@ -2725,7 +2769,7 @@ unsigned char _exclamationMarkSymbol[] = {
   _,_,_,_,_,X,X,X,X,X,_,_,_,_,_,
   _,_,_,_,_,_,X,X,X,_,_,_,_,_,_,
 };
-SDL_Texture* pExclamationMarkSymbol = convArrToSDLTex(_exclamationMarkSymbol, 15, 32);
+AtlasTex* pExclamationMarkSymbol = texAtlas.add(_exclamationMarkSymbol, 15, 32);
 unsigned char _apostropheSymbol[] = {
   _,_,_,_,_,X,X,X,X,X,_,_,_,_,_,
   _,_,_,_,_,X,X,X,X,X,_,_,_,_,_,
@@ -2760,7 +2804,7 @@ unsigned char _apostropheSymbol[] = {
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
   _,_,_,_,_,_,_,_,_,_,_,_,_,_,_,
 };
-SDL_Texture* pApostropheSymbol = convArrToSDLTex(_apostropheSymbol, 15, 32);
+AtlasTex* pApostropheSymbol = texAtlas.add(_apostropheSymbol, 15, 32);
 
 
 
@@ -2790,7 +2834,7 @@ SDL_Texture* pApostropheSymbol = convArrToSDLTex(_apostropheSymbol, 15, 32);
 /////////////////////////////////////////////////////////////////////////
 
 // SDL Frame Rendering, Textures, etc.
-static const std::vector<std::pair<int, SDL_Texture*>> P_CELL_ENERGY_TEX = {
+static const std::vector<std::pair<int, AtlasTex*>> P_CELL_ENERGY_TEX = {
   {0,     pEnergy0PctTex   }, {1,   pEnergy1PctTex }, {2,   pEnergy2PctTex},
   {3,   pEnergy3PctTex }, {4,   pEnergy4PctTex }, {5,   pEnergy5PctTex},
   {6,   pEnergy6PctTex }, {7,   pEnergy7PctTex }, {8,   pEnergy8PctTex },
@@ -2799,20 +2843,20 @@ static const std::vector<std::pair<int, SDL_Texture*>> P_CELL_ENERGY_TEX = {
   {60,  pEnergy60PctTex}, {70,  pEnergy70PctTex}, {80,  pEnergy80PctTex},
   {90,  pEnergy90PctTex}, {100, pEnergy100PctTex},
 };
-static const std::vector<std::pair<int, SDL_Texture*>> P_CELL_HEALTH_TEX = {
+static const std::vector<std::pair<int, AtlasTex*>> P_CELL_HEALTH_TEX = {
   {0,   pHealth0pctTex }, {10,  pHealth10pctTex}, {20,  pHealth20pctTex},
   {30,  pHealth30pctTex}, {40,  pHealth40pctTex}, {50,  pHealth50pctTex},
   {60,  pHealth60pctTex}, {70,  pHealth70pctTex}, {80,  pHealth80pctTex},
   {90,  pHealth90pctTex}, {100, pHealth100pctTex},
 };
-std::map<std::string, SDL_Texture*> P_EAM_TEX = {
+std::map<std::string, AtlasTex*> P_EAM_TEX = {
   {"s4", pEAMs4Tex}, {"s3", pEAMs3Tex}, {"s2", pEAMs2Tex}, {"s1", pEAMs1Tex},
   {"g4", pEAMg4Tex},
   {"c4", pEAMc4Tex}, {"c3", pEAMc3Tex}, {"c2", pEAMc2Tex}, {"c1", pEAMc1Tex},
   {"s2g2", pEAMs2g2Tex}, {"s2c2", pEAMs2c2Tex}, {"g2c2", pEAMg2c2Tex},
   {"balanced", pEAMBalancedTex},
 };
-std::vector<std::pair<int, SDL_Texture*>> P_GND_TEX = {
+std::vector<std::pair<int, AtlasTex*>> P_GND_TEX = {
   // The amount of energy per second from sunlight as a percent of
   //  the max ground energy should be described by these file names
   {0,  pEnergyGnd0pctTex }, {10, pEnergyGnd10pctTex}, {20, pEnergyGnd20pctTex},
@@ -2863,8 +2907,8 @@ SDL_Texture* load_texture(const char* filePath){
 }
 
 // sdlMap contains various thresholds which, when exceeded,
-//  Returns the corresponding SDL_Texture*
-SDL_Texture* findSDLTex(int num, const std::vector<std::pair<int, SDL_Texture*>>& sdlMap){
+//  Returns the corresponding texture
+AtlasTex* findSDLTex(int num, const std::vector<std::pair<int, AtlasTex*>>& sdlMap){
   // Use the binary search algorithm
   int iLb = 0, iUb = sdlMap.size()-1;
   while(iLb < iUb){
@@ -2878,12 +2922,10 @@ SDL_Texture* findSDLTex(int num, const std::vector<std::pair<int, SDL_Texture*>>
 
 // Draw a texture at a particular x and y position
 //  multiDraw means multiple of the drawing are made at once
-void draw_texture(SDL_Texture* pTexture, int xPos, int yPos, int width, int height, bool multiDraw = false){
+//  pSrc: The part of the texture to draw (NULL means all of it)
+void draw_texture(SDL_Texture* pTexture, int xPos, int yPos, int width, int height, bool multiDraw = false,
+    const SDL_Rect* pSrc = NULL){
   // xPos = 0, yPos = 0 refers to the top left corner of the window
-  // Not sure what pSrc refers to.
-  //  pSrc may represent the original object, but I'm not sure
-  //  If pSrc == NULL, then a new texture is rendered
-  //  Otherwise, the texture may be replaced (???)
   // pDst represents the new object
   //  If dst == NULL, then the texture fills the entire window
   SDL_Rect* pDst = new SDL_Rect;
@@ -2891,7 +2933,7 @@ void draw_texture(SDL_Texture* pTexture, int xPos, int yPos, int width, int heig
   #define draw_texture_once(_x, _y){ \
     pDst->x = _x; \
     pDst->y = _y; \
-    SDL_RenderCopy(P_RENDERER, pTexture, NULL, pDst); \
+    SDL_RenderCopy(P_RENDERER, pTexture, pSrc, pDst); \
   }
   draw_texture_once(xPos, yPos);
   if(multiDraw){
@@ -2910,16 +2952,40 @@ void draw_texture(SDL_Texture* pTexture, int xPos, int yPos, int width, int heig
   delete pDst;
   #undef draw_texture_once
 }
+// Draw an image from texAtlas
+void draw_texture(const AtlasTex* pTex, int xPos, int yPos, int width, int height, bool multiDraw = false){
+  if(pTex == NULL) return;
+  draw_texture(texAtlas.get_texture(), xPos, yPos, width, height, multiDraw, &pTex->srcRect);
+}
 
-void draw_gnd(){
-  for(int posY = 0; posY < simGndEnergy.size(); posY++){
-    for(int posX = 0; posX < simGndEnergy[posY].size(); posX++){
-      int drawX = drawScaleFactor*posX;
-      int drawY = drawScaleFactor*posY;
-      assert(drawX >= 0 && drawY >= 0 && simGndEnergy[posY][posX] >= 0);
-      SDL_Texture* pTexture = findSDLTex(0, P_GND_TEX);
-      if(maxGndEnergy.val > 0) pTexture = findSDLTex(100 * simGndEnergy[posY][posX] / maxGndEnergy.val, P_GND_TEX);
-      draw_texture(pTexture, drawX, drawY, drawScaleFactor, drawScaleFactor);
+// gndEnergy: simGndEnergy or a copy of it (e.g. from a RenderSnapshot)
+//  A chunk whose pixels all have the same energy is drawn as one rectangle
+void draw_gnd(const GndEnergyGrid& gndEnergy = simGndEnergy){
+  // The map is too large to show a pixel of it per pixel on the screen
+  if(drawScaleFactor <= 0) return;
+  auto find_gnd_tex = [&gndEnergy](int energy){
+    assert(energy >= 0);
+    if(maxGndEnergy.val > 0) return findSDLTex(100 * energy / maxGndEnergy.val, P_GND_TEX);
+    return findSDLTex(0, P_GND_TEX);
+  };
+  for(int chunkY = 0; chunkY < gndEnergy.numChunksY; chunkY++){
+    for(int chunkX = 0; chunkX < gndEnergy.numChunksX; chunkX++){
+      const GndChunk& chunk = gndEnergy.chunks[chunkY * gndEnergy.numChunksX + chunkX];
+      int lbX = chunkX * GND_CHUNK_SIDE_LEN, lbY = chunkY * GND_CHUNK_SIDE_LEN;
+      int ubX_chunk = min_int(lbX + GND_CHUNK_SIDE_LEN, gndEnergy.width);
+      int ubY_chunk = min_int(lbY + GND_CHUNK_SIDE_LEN, gndEnergy.height);
+      if(chunk.pVals == NULL){
+        draw_texture(find_gnd_tex(gndEnergy.get(lbX, lbY)), drawScaleFactor*lbX, drawScaleFactor*lbY,
+          drawScaleFactor*(ubX_chunk - lbX), drawScaleFactor*(ubY_chunk - lbY));
+        continue;
+      }
+      for(int posY = lbY; posY < ubY_chunk; posY++){
+        for(int posX = lbX; posX < ubX_chunk; posX++){
+          int drawX = drawScaleFactor*posX;
+          int drawY = drawScaleFactor*posY;
+          draw_texture(find_gnd_tex(gndEnergy.get(posX, posY)), drawX, drawY, drawScaleFactor, drawScaleFactor);
+        }
+      }
     }
   }
 }
@@ -2948,11 +3014,11 @@ void draw_bkgnd(int energyFromSunPerSec){
 }
 
 // The mask goes around the map, allowing cells to only be displayed partially on each side
-void draw_cell_mask(){
+void draw_cell_mask(const GndEnergyGrid& gndEnergy = simGndEnergy){
   SDL_SetRenderDrawColor(P_RENDERER, 0x32, 0x32, 0x32, 0xff); // grey - 0x53, 0x53, 0x53, 0xff
   SDL_Rect bkgnd = {0, 0, 0, 0};
-  int _ubX_px = drawScaleFactor * simGndEnergy[0].size(); // ubX.val;
-  int _ubY_px = drawScaleFactor * simGndEnergy.size(); // ubY.val;
+  int _ubX_px = drawScaleFactor * gndEnergy.width; // ubX.val;
+  int _ubY_px = drawScaleFactor * gndEnergy.height; // ubY.val;
   #define mask_partial(lb_x_px, lb_y_px, ub_x_px, ub_y_px) { \
     bkgnd = {lb_x_px, lb_y_px, ub_x_px, ub_y_px}; \
     SDL_RenderDrawRect(P_RENDERER, &bkgnd); \
@@ -2965,7 +3031,7 @@ void draw_cell_mask(){
   #undef mask_partial
 }
 
-SDL_Texture* retrieve_symbol_texture(char symbol){
+AtlasTex* retrieve_symbol_texture(char symbol){
   switch(symbol){
     // Digits
     case '0':
@@ -3106,14 +3172,21 @@ SDL_Texture* retrieve_symbol_texture(char symbol){
 
 void draw_empty_textbox(int x0, int y0, int width, int height, int borderThicknessPx,
     void* pRGBA_Bkgnd, void* pRGBA_Border){
-  if(borderThicknessPx){
-    SDL_Texture* pBorder = convArrToSDLTex(pRGBA_Border, 1, 1);
-    draw_texture(pBorder, x0, y0, width, height);
-  }
-  SDL_Texture* pBkgnd = convArrToSDLTex(pRGBA_Bkgnd, 1, 1);
-  draw_texture(pBkgnd, x0+borderThicknessPx, y0+borderThicknessPx,
-    width-2*borderThicknessPx, height-2*borderThicknessPx
+  // Filled rectangles, so no texture has to be uploaded every time a text box is drawn
+  //  NOTE: The draw color is restored afterwards, since SDL_RenderClear(...) uses it
+  Uint8 prevColor[4];
+  SDL_GetRenderDrawColor(P_RENDERER, &prevColor[0], &prevColor[1], &prevColor[2], &prevColor[3]);
+  auto fill_rect = [](int x, int y, int w, int h, void* pRGBA){
+    const unsigned char* rgba = (const unsigned char*)pRGBA;
+    SDL_Rect rect = {x, y, w, h};
+    SDL_SetRenderDrawColor(P_RENDERER, rgba[0], rgba[1], rgba[2], rgba[3]);
+    SDL_RenderFillRect(P_RENDERER, &rect);
+  };
+  if(borderThicknessPx) fill_rect(x0, y0, width, height, pRGBA_Border);
+  fill_rect(x0+borderThicknessPx, y0+borderThicknessPx,
+    width-2*borderThicknessPx, height-2*borderThicknessPx, pRGBA_Bkgnd
   );
+  SDL_SetRenderDrawColor(P_RENDERER, prevColor[0], prevColor[1], prevColor[2], prevColor[3]);
 }
 
 
@@ -3149,7 +3222,7 @@ void draw_text_box(int x0, int y0, int dx, int dy, int borderPx,
   draw_empty_textbox(x0, y0, dx, dy, borderPx, _RGBA_Bkgnd, _RGBA_Border);
   if(text.size() > 0) draw_text(x0, y0, dx, dy, borderPx, maxNumLines, text);
 }
-void draw_user_interface(int numAliveCells){
+void draw_user_interface(int numAliveCells, int _frameNum = frameNum){
   // Include a button for next frame, skip frames, and options
   #define dX(ixLb, ixUb) (X_VEC_GUI[ixUb] - X_VEC_GUI[ixLb])
   #define dY(iyLb, iyUb) (Y_VEC_GUI[iyUb] - Y_VEC_GUI[iyLb])
@@ -3165,7 +3238,7 @@ void draw_user_interface(int numAliveCells){
   draw_TB(2, " Options");
   draw_TB(3, "");
   #define draw_global_stats(iY, text, value) draw_text(X_VEC_GUI[3], Y_VEC_GUI[iY], dX(3,4), dY(iY,iY+1), borderPx / 2, 1, text + std::to_string(value))
-  draw_global_stats(1, " Frame #: ", frameNum);
+  draw_global_stats(1, " Frame #: ", _frameNum);
   draw_global_stats(2, " # Cells: ", numAliveCells);
   #undef draw_global_stats
   #undef draw_TB
@@ -0,0 +1,166 @@
+// An append-only log of every cell ever created, kept in a memory-mapped file
+//  Removed cells can be freed, since their lineage (parent, birth and death frames, etc.) stays on disk
+#ifndef MAIN_INCLUDES_H
+#include "../mainIncludes/mainIncludes.h"
+#define MAIN_INCLUDES_H
+#endif
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+// One record per cell, indexed by the cell's id (uniqueCellNum)
+struct LineageRecord {
+    int32_t id = -1;
+    int32_t parentId = -1; // -1 if the cell was generated from scratch
+    int32_t birthFrame = -1;
+    int32_t deathFrame = -1; // -1 until the cell dies
+    int32_t archetype = -1; // Cell type at birth (e.g. CELL_TYPE_PLANT)
+    uint32_t reserved = 0;
+    uint64_t genomeHash = 0; // Hash of the id, the stats, and the AI at birth
+};
+// The file is this header followed by header.numRecords records
+struct LineageLogHeader {
+    char magic[8] = {'W', 'R', 'L', 'I', 'N', 'E', 'A', 'G'};
+    uint32_t version = 1;
+    uint32_t recordSize = sizeof(LineageRecord);
+    int64_t numRecords = 0; // Kept up to date, so the file can be read even if the program crashes
+    int64_t reserved = 0;
+};
+
+struct LineageLog {
+    static const int64_t RECORDS_PER_GROWTH = 1 << 16; // Grow the file by 2 MB at a time
+
+    bool isOpen = false;
+    bool openFailed = false; // If true, ids are still handed out but no records are written
+    int64_t numRecords = 0;
+    char* pMap = NULL;
+    int64_t mapSize = 0; // Bytes
+    #ifdef _WIN32
+    HANDLE hFile = INVALID_HANDLE_VALUE;
+    HANDLE hMapping = NULL;
+    #else
+    int fd = -1;
+    #endif
+
+    LineageLogHeader* get_header(){ return (LineageLogHeader*)pMap; }
+    LineageRecord* get_records(){ return (LineageRecord*)(pMap + sizeof(LineageLogHeader)); }
+    int64_t calc_file_size(int64_t _numRecords){ return sizeof(LineageLogHeader) + _numRecords * sizeof(LineageRecord); }
+    int64_t get_capacity(){ return pMap == NULL ? 0 : (mapSize - (int64_t)sizeof(LineageLogHeader)) / (int64_t)sizeof(LineageRecord); }
+    // The id the next cell should use
+    int next_id(){ return numRecords; }
+    int num_records(){ return numRecords; }
+
+    // Create (or overwrite) the log file
+    bool open(const char* path){
+        assert(!isOpen);
+        #ifdef _WIN32
+        hFile = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+        if(hFile == INVALID_HANDLE_VALUE) return false;
+        #else
+        fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if(fd < 0) return false;
+        #endif
+        isOpen = true;
+        if(!map_file(calc_file_size(RECORDS_PER_GROWTH))){
+            close();
+            return false;
+        }
+        *get_header() = LineageLogHeader();
+        return true;
+    }
+    // Unmap the file and trim it to the records actually written
+    void close(){
+        if(!isOpen) return;
+        unmap_file();
+        int64_t fileSize = calc_file_size(numRecords);
+        #ifdef _WIN32
+        LARGE_INTEGER li;
+        li.QuadPart = fileSize;
+        SetFilePointerEx(hFile, li, NULL, FILE_BEGIN);
+        SetEndOfFile(hFile);
+        CloseHandle(hFile);
+        hFile = INVALID_HANDLE_VALUE;
+        #else
+        if(ftruncate(fd, fileSize) != 0) cout << "WARNING: Could not trim the lineage log\n";
+        ::close(fd);
+        fd = -1;
+        #endif
+        isOpen = false;
+    }
+    // Close the log and start the ids over from 0 (e.g. when the simulation restarts)
+    void reset(){
+        close();
+        numRecords = 0;
+        openFailed = false;
+    }
+    void append(const LineageRecord& record){
+        assert(record.id == numRecords);
+        if(!isOpen && !openFailed){
+            openFailed = !open(LINEAGE_LOG_PATH);
+            if(openFailed) cout << "WARNING: Could not open " << LINEAGE_LOG_PATH << ". The lineage of each cell will not be recorded\n";
+        }
+        if(isOpen && numRecords >= get_capacity() && !map_file(calc_file_size(numRecords + RECORDS_PER_GROWTH))){
+            cout << "WARNING: Could not grow " << LINEAGE_LOG_PATH << ". No more lineage will be recorded\n";
+            close(); // Keeps the records written so far
+            openFailed = true;
+        }
+        if(isOpen){
+            get_records()[numRecords] = record;
+            get_header()->numRecords = numRecords + 1;
+        }
+        numRecords++;
+    }
+    void record_death(int id, int frame){
+        assert(0 <= id && id < numRecords);
+        if(!isOpen) return;
+        get_records()[id].deathFrame = frame;
+    }
+
+    // (Re)map the whole file, growing it to newSize bytes
+    bool map_file(int64_t newSize){
+        assert(isOpen);
+        unmap_file();
+        #ifdef _WIN32
+        hMapping = CreateFileMappingA(hFile, NULL, PAGE_READWRITE, (DWORD)(newSize >> 32), (DWORD)(newSize & 0xFFFFFFFF), NULL);
+        if(hMapping == NULL) return false;
+        pMap = (char*)MapViewOfFile(hMapping, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)newSize);
+        if(pMap == NULL){
+            CloseHandle(hMapping);
+            hMapping = NULL;
+            return false;
+        }
+        #else
+        if(ftruncate(fd, newSize) != 0) return false;
+        void* p = mmap(NULL, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if(p == MAP_FAILED) return false;
+        pMap = (char*)p;
+        #endif
+        mapSize = newSize;
+        return true;
+    }
+    void unmap_file(){
+        if(pMap == NULL) return;
+        #ifdef _WIN32
+        UnmapViewOfFile(pMap);
+        CloseHandle(hMapping);
+        hMapping = NULL;
+        #else
+        munmap(pMap, mapSize);
+        #endif
+        pMap = NULL;
+        mapSize = 0;
+    }
+};
+LineageLog lineageLog;
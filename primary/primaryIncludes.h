@@ -5,6 +5,13 @@
 #endif
 
 #include "custom.h"
+#include "worldGrid.h"
+#include "slotPool.h"
+#include "lineageLog.h"
+#include "genome.h"
+#include "decisionLog.h"
+#include "threadSync.h"
+#include "videoExport.h"
 #include "eventHandling.h"
 #include "images.h"
 
@@ -16,7 +23,12 @@ void exit_SDL(){
     //  SDL_DestroyTexture(pTexture) for all of these textures
     for(auto pTex : SDLTextureList) SDL_DestroyTexture(pTex);
     SDL_DestroyRenderer(P_RENDERER);
+    #ifdef DO_OFFSCREEN_VIDEO
+    videoExporter.close();
+    SDL_FreeSurface(P_OFFSCREEN_SURFACE);
+    #else
     SDL_DestroyWindow(P_WINDOW);
+    #endif
     SDL_Quit();
     std::cout << "SDL is quitting!\n";
 }
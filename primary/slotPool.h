@@ -0,0 +1,54 @@
+// Memory for many objects of the same type (i.e. cells), handed out one slot at a time from large blocks
+//  Objects allocated one after another are next to each other in memory, and the slots of freed objects are reused.
+//  See sort_cell_storage() for how the cells are periodically moved into a new block in the order of their positions
+#ifndef MAIN_INCLUDES_H
+#include "../mainIncludes/mainIncludes.h"
+#define MAIN_INCLUDES_H
+#endif
+
+
+// NOTE: T may be incomplete where the pool is declared (e.g. before struct Cell), but not where it is used
+template <typename T>
+struct SlotPool {
+    struct Block {
+        T* pSlots;
+        int numSlots;
+    };
+    std::vector<Block> blocks; // Only the last block has slots which were never used
+    std::vector<void*> freeSlots; // Freed slots, reused last in first out
+    int numUsedInLastBlock = 0;
+    int numLive = 0; // Allocated and not yet freed
+
+    void* alloc(){
+        numLive++;
+        if(!freeSlots.empty()){
+            void* pSlot = freeSlots.back();
+            freeSlots.pop_back();
+            return pSlot;
+        }
+        if(blocks.empty() || numUsedInLastBlock == blocks.back().numSlots) add_block(max_int(64, numLive / 4));
+        return &blocks.back().pSlots[numUsedInLastBlock++];
+    }
+    void release(void* pSlot){
+        numLive--;
+        freeSlots.push_back(pSlot);
+    }
+    void add_block(int numSlots){
+        blocks.push_back({(T*)::operator new(numSlots * sizeof(T)), numSlots});
+        numUsedInLastBlock = 0;
+    }
+
+    // Moving every object to a new block: begin_move(...), alloc() for each object, then end_move(...)
+    //  numSlots is the size of the new block, so the objects moved into it are all next to each other
+    void begin_move(int numSlots){
+        freeSlots.clear(); // Every slot in the old blocks is about to be freed
+        add_block(numSlots);
+    }
+    // numMoved: The number of objects which were moved out of the old blocks and destroyed (without release(...))
+    //  NOTE: Nothing may live in the old blocks anymore
+    void end_move(int numMoved){
+        numLive -= numMoved;
+        for(int i = 0; i < blocks.size() - 1; i++) ::operator delete(blocks[i].pSlots);
+        blocks.erase(blocks.begin(), blocks.end() - 1);
+    }
+};
@@ -0,0 +1,270 @@
+// Structures for passing data between threads
+#ifndef MAIN_INCLUDES_H
+#include "../mainIncludes/mainIncludes.h"
+#define MAIN_INCLUDES_H
+#endif
+
+
+// The producer always has a buffer to write into and the consumer always has the latest
+//  complete buffer to read, so neither thread ever waits for the other
+//  e.g. the producer fills get_back() then calls publish(); the consumer calls update_front() then reads get_front()
+template <typename T>
+struct TripleBuffer {
+    static const int NEW_DATA = 0x04; // Set in middle until the consumer takes the buffer
+
+    T buffers[3];
+    std::atomic<int> middle{1}; // The most recently published buffer
+    int back = 0; // Only used by the producer
+    int front = 2; // Only used by the consumer
+
+    T& get_back(){ return buffers[back]; }
+    void publish(){
+        back = middle.exchange(back | NEW_DATA, std::memory_order_acq_rel) & 0x03;
+    }
+    // Returns true if a buffer was published since the last call
+    bool update_front(){
+        if((middle.load(std::memory_order_relaxed) & NEW_DATA) == 0) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & 0x03;
+        return true;
+    }
+    const T& get_front() const { return buffers[front]; }
+};
+
+// Fixed-size ring buffer. Holds up to CAPACITY - 1 items
+template <typename T, int CAPACITY>
+struct SpscQueue {
+    T items[CAPACITY];
+    std::atomic<int> head{0}; // The next item to pop (only written by the consumer)
+    std::atomic<int> tail{0}; // The next slot to push into (only written by the producer)
+
+    // Returns false (and drops the item) if the queue is full
+    bool push(const T& item){
+        int _tail = tail.load(std::memory_order_relaxed);
+        int nextTail = (_tail + 1) % CAPACITY;
+        if(nextTail == head.load(std::memory_order_acquire)) return false;
+        items[_tail] = item;
+        tail.store(nextTail, std::memory_order_release);
+        return true;
+    }
+    // Returns false if the queue is empty
+    bool pop(T& item){
+        int _head = head.load(std::memory_order_relaxed);
+        if(_head == tail.load(std::memory_order_acquire)) return false;
+        item = items[_head];
+        head.store((_head + 1) % CAPACITY, std::memory_order_release);
+        return true;
+    }
+};
+
+// Blocking queue for when the consumer has to see every item (e.g. video frames)
+//  The producer waits while the queue is full and the consumer waits while it is empty
+template <typename T>
+struct BoundedQueue {
+    std::deque<T> items;
+    int capacity = 1;
+    bool isClosed = false; // Set once the producer is done. pop() then returns false when the queue runs out
+    std::mutex mtx;
+    std::condition_variable notFull, notEmpty;
+
+    BoundedQueue(int _capacity) : capacity(_capacity) {}
+    void push(T&& item){
+        std::unique_lock<std::mutex> lock(mtx);
+        notFull.wait(lock, [this]{ return (int)items.size() < capacity; });
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+    }
+    // Returns false (and leaves the item alone) if the queue is full
+    bool try_push(T&& item){
+        std::lock_guard<std::mutex> lock(mtx);
+        if((int)items.size() >= capacity) return false;
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+    // Returns false once the queue is closed and empty
+    bool pop(T& item){
+        std::unique_lock<std::mutex> lock(mtx);
+        notEmpty.wait(lock, [this]{ return !items.empty() || isClosed; });
+        if(items.empty()) return false;
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+    // Returns false if the queue is empty
+    bool try_pop(T& item){
+        std::lock_guard<std::mutex> lock(mtx);
+        if(items.empty()) return false;
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+    void close(){
+        std::lock_guard<std::mutex> lock(mtx);
+        isClosed = true;
+        notEmpty.notify_all();
+    }
+};
+
+// Worker threads which run tasks (see TaskGraph). Each thread has its own deque of tasks: it pushes and pops
+//  at the back, and once its own deque is empty it steals from the front of the others' deques
+//  Threads outside the pool (e.g. the simulation thread) share deque 0 and can help with run_one_task()
+struct TaskPool {
+    struct TaskDeque {
+        std::deque<std::function<void()>> tasks;
+        std::mutex mtx;
+    };
+    std::vector<std::unique_ptr<TaskDeque>> deques;
+    std::vector<std::thread> threads;
+    std::atomic<int> numQueued{0};
+    bool isStopping = false;
+    std::mutex sleepMtx;
+    std::condition_variable wake;
+
+    // The deque of the current thread
+    static int& get_thread_index(){
+        static thread_local int iThread = 0;
+        return iThread;
+    }
+    ~TaskPool(){ stop(); }
+    // Does nothing if the pool is already running. With numThreads == 0, only the threads outside the pool run tasks
+    void start(int numThreads){
+        if(!deques.empty()) return;
+        isStopping = false;
+        for(int i = 0; i <= numThreads; i++) deques.push_back(std::unique_ptr<TaskDeque>(new TaskDeque()));
+        for(int i = 1; i <= numThreads; i++) threads.push_back(std::thread(&TaskPool::run_thread, this, i));
+    }
+    // Waits for the threads to finish the task they are running. Tasks still queued are dropped
+    void stop(){
+        {
+            std::lock_guard<std::mutex> lock(sleepMtx);
+            isStopping = true;
+        }
+        wake.notify_all();
+        for(auto& thread : threads) thread.join();
+        threads.clear();
+        deques.clear();
+        numQueued = 0;
+    }
+    void push(std::function<void()>&& task){
+        assert(!deques.empty());
+        TaskDeque& deque = *deques[get_thread_index()];
+        {
+            std::lock_guard<std::mutex> lock(deque.mtx);
+            deque.tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMtx);
+            numQueued++;
+        }
+        wake.notify_one();
+    }
+    // Returns false if there was no task to run
+    bool run_one_task(){
+        if(numQueued.load() == 0) return false;
+        std::function<void()> task;
+        int iThread = get_thread_index();
+        for(int i = 0; i < deques.size() && !task; i++){
+            TaskDeque& deque = *deques[(iThread + i) % deques.size()];
+            std::lock_guard<std::mutex> lock(deque.mtx);
+            if(deque.tasks.empty()) continue;
+            if(i == 0){
+                task = std::move(deque.tasks.back());
+                deque.tasks.pop_back();
+            } else {
+                task = std::move(deque.tasks.front());
+                deque.tasks.pop_front();
+            }
+        }
+        if(!task) return false;
+        numQueued--;
+        task();
+        return true;
+    }
+    void run_thread(int iThread){
+        get_thread_index() = iThread;
+        while(true){
+            if(run_one_task()) continue;
+            std::unique_lock<std::mutex> lock(sleepMtx);
+            wake.wait(lock, [this]{ return isStopping || numQueued.load() > 0; });
+            if(isStopping) return;
+        }
+    }
+};
+TaskPool taskPool;
+
+// Phases of work, each of which waits for the phases it depends on. run() starts every phase as soon as
+//  the phases before it are done, so independent phases overlap, and returns once all of them are done
+//  Pinned phases always run on the thread which called run(), e.g. because they draw from rand(),
+//  which may be per thread (e.g. on Windows). The other phases run on taskPool
+struct TaskGraph {
+    struct Task {
+        const char* name;
+        std::function<void()> func;
+        bool isPinned = true;
+        std::vector<int> dependents;
+        int numDeps = 0;
+        std::atomic<int> numDepsLeft{0};
+    };
+    std::deque<Task> tasks; // NOTE: Not a vector, since Task can't be moved
+    std::atomic<int> numTasksLeft{0};
+    std::mutex pinnedMtx;
+    std::deque<int> readyPinnedTasks;
+
+    // Returns the id of the task, for later tasks to depend on. Negative ids are ignored (e.g. phases which were left out)
+    int add(const char* name, std::function<void()> func, std::initializer_list<int> deps = {}, bool isPinned = true){
+        tasks.emplace_back();
+        Task& task = tasks.back();
+        task.name = name;
+        task.func = std::move(func);
+        task.isPinned = isPinned;
+        int id = tasks.size() - 1;
+        for(int dep : deps){
+            if(dep < 0) continue;
+            assert(dep < id);
+            tasks[dep].dependents.push_back(id);
+            task.numDeps++;
+        }
+        return id;
+    }
+    void clear(){ tasks.clear(); }
+    void run(){
+        if(tasks.empty()) return;
+        taskPool.start(NUM_TASK_THREADS - 1);
+        numTasksLeft = tasks.size();
+        readyPinnedTasks.clear();
+        for(auto& task : tasks) task.numDepsLeft = task.numDeps;
+        for(int id = 0; id < tasks.size(); id++){
+            if(tasks[id].numDeps == 0) make_ready(id);
+        }
+        while(numTasksLeft.load() > 0){
+            int id = -1;
+            {
+                std::lock_guard<std::mutex> lock(pinnedMtx);
+                if(!readyPinnedTasks.empty()){
+                    id = readyPinnedTasks.front();
+                    readyPinnedTasks.pop_front();
+                }
+            }
+            if(id >= 0) run_task(id);
+            else if(!taskPool.run_one_task()) std::this_thread::yield();
+        }
+    }
+    void make_ready(int id){
+        if(!tasks[id].isPinned){
+            taskPool.push([this, id]{ run_task(id); });
+            return;
+        }
+        std::lock_guard<std::mutex> lock(pinnedMtx);
+        readyPinnedTasks.push_back(id);
+    }
+    void run_task(int id){
+        Task& task = tasks[id];
+        task.func();
+        for(int dependent : task.dependents){
+            if(--tasks[dependent].numDepsLeft == 0) make_ready(dependent);
+        }
+        numTasksLeft--;
+    }
+};
@@ -0,0 +1,134 @@
+// Writes video frames to a file or a pipe on a separate thread (see DO_OFFSCREEN_VIDEO in debug.h)
+#ifndef MAIN_INCLUDES_H
+#include "../mainIncludes/mainIncludes.h"
+#define MAIN_INCLUDES_H
+#endif
+
+
+struct VideoFrame {
+    int width = 0, height = 0;
+    std::vector<Uint32> pixels; // ARGB8888, row by row without any padding
+};
+
+// The simulation copies each frame into the queue and goes on to the next one while the writer thread
+//  converts the frame and writes it out
+//  Output is either one Y4M stream (4:4:4, so odd frame sizes work) or a stream of binary PPM images
+struct VideoExporter {
+    FILE* pFile = NULL;
+    bool isPipe = false;
+    bool isY4m = VIDEO_EXPORT_Y4M;
+    BoundedQueue<VideoFrame> frames{VIDEO_EXPORT_QUEUE_LEN};
+    BoundedQueue<VideoFrame> freeFrames{VIDEO_EXPORT_QUEUE_LEN + 1}; // Reused so copying a frame does not allocate
+    std::thread writerThread;
+    int numFramesAdded = 0, numFramesDropped = 0;
+
+    bool is_open(){ return pFile != NULL; }
+    bool open(const char* path){
+        assert(!is_open());
+        isPipe = (path[0] == '|');
+        pFile = isPipe ? popen(path + 1, "w") : fopen(path, "wb");
+        if(pFile == NULL) return false;
+        writerThread = std::thread(&VideoExporter::run_writer, this);
+        return true;
+    }
+    // Copy the surface into the queue. Returns false if the frame was dropped
+    bool add_frame(SDL_Surface* pSurface){
+        assert(is_open());
+        VideoFrame frame;
+        if(!freeFrames.try_pop(frame)) frame.pixels.reserve(pSurface->w * pSurface->h);
+        frame.width = pSurface->w;
+        frame.height = pSurface->h;
+        frame.pixels.resize(frame.width * frame.height);
+        SDL_LockSurface(pSurface);
+        for(int y = 0; y < frame.height; y++){
+            const Uint8* pRow = (const Uint8*)pSurface->pixels + y * pSurface->pitch;
+            memcpy(&frame.pixels[y * frame.width], pRow, frame.width * sizeof(Uint32));
+        }
+        SDL_UnlockSurface(pSurface);
+
+        if(VIDEO_EXPORT_DROP_FRAMES){
+            if(!frames.try_push(std::move(frame))){
+                numFramesDropped++;
+                return false;
+            }
+        } else {
+            frames.push(std::move(frame));
+        }
+        numFramesAdded++;
+        return true;
+    }
+    // Wait for the writer thread to finish all queued frames
+    void close(){
+        if(!is_open()) return;
+        frames.close();
+        writerThread.join();
+        if(isPipe) pclose(pFile);
+        else fclose(pFile);
+        pFile = NULL;
+        std::cout << "Exported " << numFramesAdded << " video frames (" << numFramesDropped << " dropped)\n";
+    }
+
+    void run_writer(){
+        std::vector<unsigned char> bytes;
+        VideoFrame frame;
+        bool isFirstFrame = true;
+        while(frames.pop(frame)){
+            const int numPixels = frame.width * frame.height;
+            bytes.clear();
+            if(isY4m){
+                if(isFirstFrame){
+                    std::string header = "YUV4MPEG2 W" + std::to_string(frame.width) + " H" + std::to_string(frame.height)
+                        + " F" + std::to_string(VIDEO_EXPORT_FPS) + ":1 Ip A1:1 C444\n";
+                    bytes.insert(bytes.end(), header.begin(), header.end());
+                }
+                static const char FRAME_HEADER[] = "FRAME\n";
+                bytes.insert(bytes.end(), FRAME_HEADER, FRAME_HEADER + 6);
+                size_t planeY = bytes.size();
+                bytes.resize(planeY + 3 * numPixels);
+                unsigned char* pY = &bytes[planeY];
+                unsigned char* pU = pY + numPixels;
+                unsigned char* pV = pU + numPixels;
+                // BT.601, limited range
+                for(int i = 0; i < numPixels; i++){
+                    int r = (frame.pixels[i] >> 16) & 0xff, g = (frame.pixels[i] >> 8) & 0xff, b = frame.pixels[i] & 0xff;
+                    pY[i] = (( 66*r + 129*g +  25*b + 128) >> 8) + 16;
+                    pU[i] = ((-38*r -  74*g + 112*b + 128) >> 8) + 128;
+                    pV[i] = ((112*r -  94*g -  18*b + 128) >> 8) + 128;
+                }
+            } else {
+                std::string header = "P6\n" + std::to_string(frame.width) + " " + std::to_string(frame.height) + "\n255\n";
+                bytes.insert(bytes.end(), header.begin(), header.end());
+                size_t start = bytes.size();
+                bytes.resize(start + 3 * numPixels);
+                unsigned char* pRgb = &bytes[start];
+                for(int i = 0; i < numPixels; i++){
+                    pRgb[3*i]     = (frame.pixels[i] >> 16) & 0xff;
+                    pRgb[3*i + 1] = (frame.pixels[i] >> 8) & 0xff;
+                    pRgb[3*i + 2] = frame.pixels[i] & 0xff;
+                }
+            }
+            isFirstFrame = false;
+            if(fwrite(bytes.data(), 1, bytes.size(), pFile) != bytes.size()){
+                std::cout << "WARNING: Could not write a video frame\n";
+            }
+            freeFrames.try_push(std::move(frame));
+        }
+        fflush(pFile);
+    }
+};
+
+#ifdef DO_OFFSCREEN_VIDEO
+VideoExporter videoExporter;
+// Call after each frame has been drawn. The simulation quits once VIDEO_EXPORT_NUM_FRAMES frames are exported
+void export_video_frame(){
+    static int numFramesDrawn = 0;
+    if(numFramesDrawn++ % VIDEO_EXPORT_FRAME_STRIDE != 0) return;
+    if(!videoExporter.is_open() && !videoExporter.open(VIDEO_EXPORT_PATH)){
+        std::cout << "WARNING: Could not open " << VIDEO_EXPORT_PATH << ". No video will be exported\n";
+        simState = SIM_STATE_QUIT;
+        return;
+    }
+    videoExporter.add_frame(P_OFFSCREEN_SURFACE);
+    if(videoExporter.numFramesAdded >= VIDEO_EXPORT_NUM_FRAMES) simState = SIM_STATE_QUIT;
+}
+#endif
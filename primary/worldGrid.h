@@ -0,0 +1,227 @@
+// Grids over the whole map, split into square chunks which are only allocated once something is stored in them
+//  Most of a large map is usually empty (or all at the same ground energy), so memory grows with what is in it
+//  instead of with ubX.val * ubY.val
+#ifndef MAIN_INCLUDES_H
+#include "../mainIncludes/mainIncludes.h"
+#define MAIN_INCLUDES_H
+#endif
+
+
+// GND_CHUNK_SIDE_LEN x GND_CHUNK_SIDE_LEN pixels of ground energy
+struct GndChunk {
+    std::shared_ptr<std::vector<uint16_t>> pVals; // Row by row. NULL while every pixel is uniformVal
+    uint16_t uniformVal = 0;
+};
+
+// The energy in the ground of every pixel (see init_sim_gnd_energy(...))
+//  A chunk is a single value until one of its pixels changes on its own (e.g. a worm eats from it), and
+//  collapses back to a single value once its pixels are the same again (e.g. every pixel is saturated)
+//  Energy is stored in 16 bits, in units of unitEnergy. This is 1 (i.e. exact) unless maxGndEnergy is larger
+//  than 65535 when the grid is initialized, in which case the energy of each pixel is rounded down
+//  Copies (e.g. RenderSnapshot::gndEnergy) share the chunks until either of them changes one
+struct GndEnergyGrid {
+    int width = 0, height = 0; // In pixels
+    int numChunksX = 0, numChunksY = 0;
+    int unitEnergy = 1;
+    std::vector<GndChunk> chunks; // Row by row
+
+    void init(int _width, int _height, int maxEnergy, int initEnergy){
+        width = _width;
+        height = _height;
+        numChunksX = (width + GND_CHUNK_SIDE_LEN - 1) / GND_CHUNK_SIDE_LEN;
+        numChunksY = (height + GND_CHUNK_SIDE_LEN - 1) / GND_CHUNK_SIDE_LEN;
+        unitEnergy = max_int((maxEnergy + UINT16_MAX - 1) / UINT16_MAX, 1);
+        GndChunk chunk;
+        chunk.uniformVal = to_units(initEnergy);
+        chunks.assign(numChunksX * numChunksY, chunk);
+    }
+    bool empty() const { return chunks.empty(); }
+    uint16_t to_units(int energy) const { return saturate_int(energy / unitEnergy, 0, UINT16_MAX); }
+
+    int get(int posX, int posY) const {
+        assert(0 <= posX && posX < width && 0 <= posY && posY < height);
+        const GndChunk& chunk = chunks[(posY / GND_CHUNK_SIDE_LEN) * numChunksX + posX / GND_CHUNK_SIDE_LEN];
+        if(chunk.pVals == NULL) return chunk.uniformVal * unitEnergy;
+        return (*chunk.pVals)[(posY % GND_CHUNK_SIDE_LEN) * GND_CHUNK_SIDE_LEN + posX % GND_CHUNK_SIDE_LEN] * unitEnergy;
+    }
+    void set(int posX, int posY, int energy){
+        assert(0 <= posX && posX < width && 0 <= posY && posY < height);
+        GndChunk& chunk = chunks[(posY / GND_CHUNK_SIDE_LEN) * numChunksX + posX / GND_CHUNK_SIDE_LEN];
+        uint16_t val = to_units(energy);
+        if(chunk.pVals == NULL && chunk.uniformVal == val) return;
+        edit_chunk(chunk)[(posY % GND_CHUNK_SIDE_LEN) * GND_CHUNK_SIDE_LEN + posX % GND_CHUNK_SIDE_LEN] = val;
+    }
+    // Add energy to every pixel, up to maxEnergy (see increase_sim_gnd_energy(...))
+    void add_to_all(int energy, int maxEnergy){
+        for(auto& chunk : chunks){
+            if(chunk.pVals == NULL){
+                chunk.uniformVal = to_units(min_int(chunk.uniformVal * unitEnergy + energy, maxEnergy));
+                continue;
+            }
+            std::vector<uint16_t>& vals = edit_chunk(chunk);
+            bool isUniform = true;
+            for(auto& val : vals){
+                val = to_units(min_int(val * unitEnergy + energy, maxEnergy));
+                isUniform = isUniform && val == vals[0];
+            }
+            if(!isUniform) continue;
+            chunk.uniformVal = vals[0];
+            chunk.pVals = NULL;
+        }
+    }
+    // The pixels of the chunk, copied first if they are shared (or allocated if the chunk is uniform)
+    std::vector<uint16_t>& edit_chunk(GndChunk& chunk){
+        if(chunk.pVals == NULL) chunk.pVals = std::make_shared<std::vector<uint16_t>>(GND_CHUNK_SIDE_LEN * GND_CHUNK_SIDE_LEN, chunk.uniformVal);
+        else if(chunk.pVals.use_count() > 1) chunk.pVals = std::make_shared<std::vector<uint16_t>>(*chunk.pVals);
+        return *chunk.pVals;
+    }
+    int num_allocated_chunks() const {
+        int ans = 0;
+        for(auto& chunk : chunks) ans += (chunk.pVals != NULL);
+        return ans;
+    }
+};
+GndEnergyGrid simGndEnergy;
+
+// A T for every cell region (e.g. the cells in it), in chunks of REGION_CHUNK_SIDE_LEN x REGION_CHUNK_SIDE_LEN regions
+//  Regions are {xReg, yReg} pairs like Cell::xyRegion. A chunk is allocated the first time one of its regions is
+//  written to, and then kept, since cells usually come back to where they have been
+//  NOTE: T needs a clear() method
+template <typename T>
+struct RegionGrid {
+    int numRegionsX = 0, numRegionsY = 0;
+    int numChunksX = 0, numChunksY = 0;
+    std::vector<std::unique_ptr<T[]>> chunks; // Row by row
+
+    // Does nothing if the size is the same
+    void resize(int _numRegionsX, int _numRegionsY){
+        if(_numRegionsX == numRegionsX && _numRegionsY == numRegionsY) return;
+        numRegionsX = _numRegionsX;
+        numRegionsY = _numRegionsY;
+        numChunksX = (numRegionsX + REGION_CHUNK_SIDE_LEN - 1) / REGION_CHUNK_SIDE_LEN;
+        numChunksY = (numRegionsY + REGION_CHUNK_SIDE_LEN - 1) / REGION_CHUNK_SIDE_LEN;
+        chunks.clear();
+        chunks.resize(numChunksX * numChunksY);
+    }
+    // Allocates the region's chunk if it isn't yet
+    T& operator[](std::pair<int,int> reg){
+        assert(0 <= reg.first && reg.first < numRegionsX && 0 <= reg.second && reg.second < numRegionsY);
+        std::unique_ptr<T[]>& pChunk = chunks[(reg.second / REGION_CHUNK_SIDE_LEN) * numChunksX + reg.first / REGION_CHUNK_SIDE_LEN];
+        if(pChunk == NULL) pChunk.reset(new T[REGION_CHUNK_SIDE_LEN * REGION_CHUNK_SIDE_LEN]);
+        return pChunk[(reg.second % REGION_CHUNK_SIDE_LEN) * REGION_CHUNK_SIDE_LEN + reg.first % REGION_CHUNK_SIDE_LEN];
+    }
+    // NULL if the region's chunk was never written to (i.e. the region is empty)
+    const T* find(std::pair<int,int> reg) const {
+        if(reg.first < 0 || reg.first >= numRegionsX || reg.second < 0 || reg.second >= numRegionsY) return NULL;
+        const std::unique_ptr<T[]>& pChunk = chunks[(reg.second / REGION_CHUNK_SIDE_LEN) * numChunksX + reg.first / REGION_CHUNK_SIDE_LEN];
+        if(pChunk == NULL) return NULL;
+        return &pChunk[(reg.second % REGION_CHUNK_SIDE_LEN) * REGION_CHUNK_SIDE_LEN + reg.first % REGION_CHUNK_SIDE_LEN];
+    }
+    // Empty every region, keeping the chunks (and the memory of each region) for reuse
+    void clear(){
+        for(auto& pChunk : chunks){
+            if(pChunk == NULL) continue;
+            for(int i = 0; i < REGION_CHUNK_SIDE_LEN * REGION_CHUNK_SIDE_LEN; i++) pChunk[i].clear();
+        }
+    }
+    int num_allocated_chunks() const {
+        int ans = 0;
+        for(auto& pChunk : chunks) ans += (pChunk != NULL);
+        return ans;
+    }
+};
+
+// The number of cells in every block of regions, at several levels of coarseness
+//  Level 0 counts the cells in blocks of baseSideLen x baseSideLen regions, and every level above it counts blocks of
+//  REGION_COUNTS_FANOUT x REGION_COUNTS_FANOUT blocks of the level below. A search over a large box of regions
+//  (e.g. for a long-sighted cell) only goes down into the blocks with cells in them instead of visiting every region
+//  NOTE: clear() only resets the blocks which had cells, so large, mostly empty maps cost nothing extra
+struct RegionCounts {
+    struct Level {
+        int sideLen = 1; // In regions
+        int numBlocksX = 0, numBlocksY = 0;
+        std::vector<int> counts; // Row by row
+    };
+    int numRegionsX = 0, numRegionsY = 0;
+    std::vector<Level> levels; // From the finest to the coarsest
+    std::vector<std::pair<int,int>> occupiedRegions; // One region in each block of level 0 which has cells
+
+    // Does nothing if the size is the same
+    void resize(int _numRegionsX, int _numRegionsY, int baseSideLen){
+        if(_numRegionsX == numRegionsX && _numRegionsY == numRegionsY && baseSideLen == get_base_side_len()) return;
+        numRegionsX = _numRegionsX;
+        numRegionsY = _numRegionsY;
+        levels.clear();
+        occupiedRegions.clear();
+        for(int sideLen = baseSideLen; true; sideLen *= REGION_COUNTS_FANOUT){
+            Level level;
+            level.sideLen = sideLen;
+            level.numBlocksX = (numRegionsX + sideLen - 1) / sideLen;
+            level.numBlocksY = (numRegionsY + sideLen - 1) / sideLen;
+            level.counts.assign(level.numBlocksX * level.numBlocksY, 0);
+            levels.push_back(std::move(level));
+            if(levels.back().counts.size() <= REGION_COUNTS_FANOUT * REGION_COUNTS_FANOUT) break;
+        }
+    }
+    int get_base_side_len() const { return levels.empty() ? 0 : levels[0].sideLen; }
+    int& count_at(int iLevel, std::pair<int,int> reg){
+        Level& level = levels[iLevel];
+        return level.counts[(reg.second / level.sideLen) * level.numBlocksX + reg.first / level.sideLen];
+    }
+    void add(std::pair<int,int> reg){
+        assert(0 <= reg.first && reg.first < numRegionsX && 0 <= reg.second && reg.second < numRegionsY);
+        if(count_at(0, reg) == 0) occupiedRegions.push_back(reg);
+        for(int iLevel = 0; iLevel < levels.size(); iLevel++) count_at(iLevel, reg)++;
+    }
+    void clear(){
+        for(auto reg : occupiedRegions){
+            for(int iLevel = 0; iLevel < levels.size(); iLevel++) count_at(iLevel, reg) = 0;
+        }
+        occupiedRegions.clear();
+    }
+
+    // Call fn({xReg, yReg}) for every region of the box which may have cells in it (i.e. is in a block with cells)
+    //  The box is numRegX x numRegY regions from {xRegLb, yRegLb}, and wraps around the map like the bounds from
+    //  Cell::get_xyRegion_neighborhoodBounds(...). NOTE: The regions are not visited in any particular order
+    template <typename Func>
+    void for_each_region(int xRegLb, int numRegX, int yRegLb, int numRegY, Func fn) const {
+        // Split the box where it wraps around
+        int xLbs[2] = {xRegLb, 0}, xUbs[2] = {min_int(xRegLb + numRegX, numRegionsX), xRegLb + numRegX - numRegionsX};
+        int yLbs[2] = {yRegLb, 0}, yUbs[2] = {min_int(yRegLb + numRegY, numRegionsY), yRegLb + numRegY - numRegionsY};
+        for(int i = 0; i < 2; i++){
+            for(int j = 0; j < 2; j++){
+                if(xUbs[i] <= xLbs[i] || yUbs[j] <= yLbs[j]) continue;
+                if(levels.empty()){
+                    for(int xReg = xLbs[i]; xReg < xUbs[i]; xReg++){
+                        for(int yReg = yLbs[j]; yReg < yUbs[j]; yReg++) fn(std::pair<int,int>(xReg, yReg));
+                    }
+                    continue;
+                }
+                const Level& top = levels.back();
+                visit_blocks(levels.size() - 1, 0, top.numBlocksX, 0, top.numBlocksY, xLbs[i], xUbs[i], yLbs[j], yUbs[j], fn);
+            }
+        }
+    }
+    // Go down into the blocks of the level in [bXLb, bXUb) x [bYLb, bYUb) which overlap the box [xLb, xUb) x [yLb, yUb)
+    template <typename Func>
+    void visit_blocks(int iLevel, int bXLb, int bXUb, int bYLb, int bYUb, int xLb, int xUb, int yLb, int yUb, Func& fn) const {
+        const Level& level = levels[iLevel];
+        int sideLen = level.sideLen;
+        bXLb = max_int(bXLb, xLb / sideLen); bXUb = min_int(bXUb, (xUb + sideLen - 1) / sideLen);
+        bYLb = max_int(bYLb, yLb / sideLen); bYUb = min_int(bYUb, (yUb + sideLen - 1) / sideLen);
+        for(int bY = bYLb; bY < bYUb; bY++){
+            for(int bX = bXLb; bX < bXUb; bX++){
+                if(level.counts[bY * level.numBlocksX + bX] == 0) continue;
+                if(iLevel > 0){
+                    visit_blocks(iLevel - 1, bX * REGION_COUNTS_FANOUT, (bX + 1) * REGION_COUNTS_FANOUT,
+                        bY * REGION_COUNTS_FANOUT, (bY + 1) * REGION_COUNTS_FANOUT, xLb, xUb, yLb, yUb, fn);
+                    continue;
+                }
+                int xRegUb = min_int((bX + 1) * sideLen, xUb), yRegUb = min_int((bY + 1) * sideLen, yUb);
+                for(int xReg = max_int(bX * sideLen, xLb); xReg < xRegUb; xReg++){
+                    for(int yReg = max_int(bY * sideLen, yLb); yReg < yRegUb; yReg++) fn(std::pair<int,int>(xReg, yReg));
+                }
+            }
+        }
+    }
+};
@@ -8,112 +8,275 @@
 
 struct Cell;
 
-// First, define a node
 static const int ACT_FCN_IDENTITY = 0;
 static const std::vector<int> VALID_ACT_FCNS = {ACT_FCN_IDENTITY};
 static const int NUM_HIDDEN_LAYER_NODES = 10;
-struct aiNode {
-    // Essentially a node in an artificial neural network (ANN)
+bool activation_fcn_is_valid(int activationFcn){
+    for(auto validFcn : VALID_ACT_FCNS) {
+        if(activationFcn == validFcn) return true;
+    }
+    std::cout << "The activation function, represented by the number " << activationFcn;
+    std::cout << ", is either invalid or unaccounted for!!!" << std::endl;
+    return false;
+}
+float calc_act_fcn(float actFcnInput, int activationFcn){
+    switch(activationFcn){
+        case ACT_FCN_IDENTITY:
+        return actFcnInput;
+        default:
+        assert(activation_fcn_is_valid(activationFcn));
+        std::cout << "The activation function is valid, but NOT accounted for in this function!!!";
+        assert(false);
+    }
+    return 0;
+}
 
-    // Identity
-    int id = -1;
+// Quantize vals to int8 with one scale for all of them, i.e. vals[i] ~= qVals[i] * (returned scale)
+//  The largest magnitude maps to 127, so the values are normalized whatever their range
+float quantize_int8(const float* vals, int numVals, int8_t* qVals){
+    float maxAbs = 0;
+    for(int i = 0; i < numVals; i++) maxAbs = max_float(maxAbs, abs_float(vals[i]));
+    float scale = (maxAbs > 0) ? maxAbs / 127 : 1;
+    for(int i = 0; i < numVals; i++) qVals[i] = (int8_t)saturate_int(std::lround(vals[i] / scale), -127, 127);
+    return scale;
+}
+// A plain loop over contiguous int8 arrays with an int32 sum, so the compiler can turn it into SIMD multiply-adds
+int32_t dot_int8(const int8_t* a, const int8_t* b, int n){
+    int32_t sum = 0;
+    for(int i = 0; i < n; i++) sum += (int16_t)a[i] * (int16_t)b[i];
+    return sum;
+}
 
-    // Parameters
-    bool isInput = false;
-    //bool isOutput = false;
+// An artificial neural network (ANN) stored as one contiguous block of floats, so a whole brain is a single allocation
+//  Each node (except the input nodes) is its bias followed by one weight per node in the previous layer.
+//  The nodes are stored layer by layer, and the first node of layer layerNum is at params[layerStart[layerNum]]
+//  NOTE: Clones share their parent's brain until one of them changes it (see Cell::get_mutable_brain())
+struct AiBrain {
+    // Topology
+    std::vector<int> nodesPerLayer; // Including the input (first) and output (last) layers
+    std::vector<int> layerStart; // Unused for the input layer
     int activationFcn = ACT_FCN_IDENTITY;
     float stddevWB = 0.2; // The standard deviation of the bias and weights when they mutate
 
     // Mutateable parameters (controlled by 'genome')
-    float bias = 0;     // Add this to the weighted sum
-    std::vector<float> inputWeights; // Multiply each previous node output by a weight
-    //std::vector<float> prevNodeOutputs; // The outputs of each previous node (keep empty if isInput == true)
-    
-    // Outputs and intermediate values
-    float weightedSum = 0; // equal to the sum of bias + inputWeights[i]*prevNodeOutputs[i]
-    float outputVal = 0;
+    std::vector<float> params;
 
-    // Calculated values
-    int numWeights = -1;     // equal to (# of previous layer nodes)
+    // One per input node. Each input is divided by its scale before it is quantized, so every input feature uses
+    //  the whole int8 range whatever its units (see Cell::get_ai_input_scales()). Inputs beyond their scale saturate
+    std::vector<float> inputScales;
+    // The input nodes sorted by their scale, so the int8 AI can sum each run of inputs with the same scale on its own
+    //  The runs start at inputOrder[inputGroupStart[iGroup]], and the last entry of inputGroupStart is the number of inputs
+    std::vector<int> inputOrder;
+    std::vector<int> inputGroupStart;
 
-    // Struct-specific functions
-    bool activation_fcn_is_valid(){
-        for(auto validFcn : VALID_ACT_FCNS) {
-            if(activationFcn == validFcn) return true;
+    // The weights quantized to int8 with one scale per layer (see quantize()), used unless aiInferenceMode is AI_INFERENCE_FLOAT
+    //  The weights of node nodeNum in layer layerNum start at qWeights[qLayerStart[layerNum] + nodeNum * num_weights_per_node(layerNum)]
+    //  The biases stay in params, and the weights of the first hidden layer are stored in the order of inputOrder
+    std::vector<int8_t> qWeights;
+    std::vector<int> qLayerStart;
+    std::vector<float> qWeightScales; // Per layer: weight ~= qWeight * qWeightScales[layerNum]
+
+    int num_layers() const { return nodesPerLayer.size(); }
+    int num_nodes(int layerNum) const { return nodesPerLayer[layerNum]; }
+    // Same as the number of nodes in the previous layer
+    int num_weights_per_node(int layerNum) const { return nodesPerLayer[layerNum-1]; }
+    // {bias, w1, w2, ...} of a node
+    float* get_node_params(int layerNum, int nodeNum){
+        return &params[layerStart[layerNum] + nodeNum * (1 + num_weights_per_node(layerNum))];
+    }
+    const float* get_node_params(int layerNum, int nodeNum) const {
+        return &params[layerStart[layerNum] + nodeNum * (1 + num_weights_per_node(layerNum))];
+    }
+    // The biases start at 0 and the weights are drawn from a standard normal distribution
+    //  Without _inputScales, every input is expected to be within [-1, 1]
+    void init_brain(const std::vector<int>& _nodesPerLayer, const std::vector<float>& _inputScales = {}){
+        nodesPerLayer = _nodesPerLayer;
+        inputScales = _inputScales;
+        if(inputScales.empty()) inputScales.assign(num_nodes(0), 1);
+        group_inputs_by_scale();
+        layerStart.assign(num_layers(), 0);
+        int numParams = 0;
+        for(int layerNum = 1; layerNum < num_layers(); layerNum++){
+            layerStart[layerNum] = numParams;
+            numParams += num_nodes(layerNum) * (1 + num_weights_per_node(layerNum));
+        }
+        params.assign(numParams, 0);
+        for(int layerNum = 1; layerNum < num_layers(); layerNum++){
+            for(int nodeNum = 0; nodeNum < num_nodes(layerNum); nodeNum++){
+                float* pNode = get_node_params(layerNum, nodeNum);
+                for(int i = 1; i <= num_weights_per_node(layerNum); i++) pNode[i] = gen_normal_dist(rng, 0, 1);
+            }
         }
-        std::cout << "The activation function, represented by the number " << activationFcn;
-        std::cout << ", is either invalid or unaccounted for!!!" << std::endl;
-        return false;
+        quantize();
+        verify_brain_validity();
     }
-    bool verify_node_validity(){
-        assert(id >= 0);
-        //assert(pCell != NULL);
-        if(isInput) {
-            std::cout << "Input nodes do NOT need to be defined!!!" << std::endl;
-            assert(false);
+    void group_inputs_by_scale(){
+        inputOrder.resize(num_nodes(0));
+        for(int i = 0; i < inputOrder.size(); i++) inputOrder[i] = i;
+        std::stable_sort(inputOrder.begin(), inputOrder.end(), [&](int a, int b){ return inputScales[a] < inputScales[b]; });
+        inputGroupStart.clear();
+        for(int i = 0; i < inputOrder.size(); i++){
+            if(i == 0 || inputScales[inputOrder[i]] != inputScales[inputOrder[i-1]]) inputGroupStart.push_back(i);
         }
-        assert(numWeights >= 0);
-        assert(activation_fcn_is_valid());
-        assert(inputWeights.size() == numWeights);
+        inputGroupStart.push_back(inputOrder.size());
+    }
+    // Call this whenever params change
+    void quantize(){
+        qWeights.resize(params.size());
+        qLayerStart.assign(num_layers(), 0);
+        qWeightScales.assign(num_layers(), 1);
+        std::vector<float> layerWeights;
+        int numQWeights = 0;
+        for(int layerNum = 1; layerNum < num_layers(); layerNum++){
+            int numWeights = num_weights_per_node(layerNum);
+            layerWeights.clear();
+            for(int nodeNum = 0; nodeNum < num_nodes(layerNum); nodeNum++){
+                const float* pNode = get_node_params(layerNum, nodeNum);
+                for(int i = 0; i < numWeights; i++) layerWeights.push_back(pNode[1 + ((layerNum == 1) ? inputOrder[i] : i)]);
+            }
+            qLayerStart[layerNum] = numQWeights;
+            qWeightScales[layerNum] = quantize_int8(layerWeights.data(), layerWeights.size(), &qWeights[numQWeights]);
+            numQWeights += layerWeights.size();
+        }
+        qWeights.resize(numQWeights);
+    }
+    bool verify_brain_validity() const {
+        assert(num_layers() >= 2);
+        for(auto num : nodesPerLayer) assert(0 < num);
+        assert(layerStart.size() == num_layers());
+        int lastLayer = num_layers() - 1;
+        assert(params.size() == layerStart[lastLayer] + num_nodes(lastLayer) * (1 + num_weights_per_node(lastLayer)));
+        assert(activation_fcn_is_valid(activationFcn));
         assert(stddevWB >= 0);
+        assert(qLayerStart.size() == num_layers() && qWeightScales.size() == num_layers());
+        assert(inputScales.size() == num_nodes(0));
+        for(auto inputScale : inputScales) assert(inputScale > 0);
+        assert(inputOrder.size() == num_nodes(0) && inputGroupStart.back() == num_nodes(0));
         return true;
     }
-    void init_node(int _id, bool _isInput, int numNodesInPrevLayer){
-        id = _id;
-        isInput = _isInput;
-        numWeights = numNodesInPrevLayer;
-        for(int i = 0; i < numWeights; i++) {
-            inputWeights.push_back(gen_normal_dist(rng, 0, 1));
+    // Calculate the outputs of every node in layerNum from the outputs of the previous layer
+    //  (layerNum == 0 means the input layer)
+    void do_forward_prop_1_layer(const std::vector<float>& prevLayerOutputs, int layerNum, std::vector<float>& layerOutputs) const {
+        int numWeights = num_weights_per_node(layerNum);
+        assert(prevLayerOutputs.size() == numWeights);
+        layerOutputs.resize(num_nodes(layerNum));
+        for(int nodeNum = 0; nodeNum < num_nodes(layerNum); nodeNum++){
+            const float* pNode = get_node_params(layerNum, nodeNum);
+            float weightedSum = pNode[0]; // bias + inputWeights[i]*prevNodeOutputs[i]
+            for(int i = 0; i < numWeights; i++){
+                weightedSum += prevLayerOutputs[i] * pNode[1 + i];
+            }
+            layerOutputs[nodeNum] = calc_act_fcn(weightedSum, activationFcn);
         }
-        verify_node_validity();
     }
-    float calc_act_fcn(float actFcnInput, int activationFcn){
-        switch(activationFcn){
-            case ACT_FCN_IDENTITY:
-            return actFcnInput;
-            default:
-            assert(activation_fcn_is_valid());
-            std::cout << "The activation function is valid, but NOT accounted for in this function!!!";
-            assert(false);
+    // Same as do_forward_prop_1_layer(...), but with int8 weights and inputs, and the sums are converted back to float
+    //  The cell's inputs are normalized by inputScales, so 127 is the whole scale of each input, and each group of inputs
+    //  with the same scale is summed on its own. The hidden layers' outputs are quantized with one scale for the whole layer
+    void do_forward_prop_1_layer_int8(const std::vector<float>& prevLayerOutputs, int layerNum, std::vector<float>& layerOutputs) const {
+        int numWeights = num_weights_per_node(layerNum);
+        assert(prevLayerOutputs.size() == numWeights);
+        static thread_local std::vector<int8_t> qInputs;
+        static thread_local std::vector<int> groupStart;
+        static thread_local std::vector<float> groupScales; // input ~= qInput * groupScale
+        qInputs.resize(numWeights);
+        if(layerNum == 1){
+            for(int i = 0; i < numWeights; i++){
+                int iInput = inputOrder[i];
+                qInputs[i] = (int8_t)saturate_int(std::lround(127 * prevLayerOutputs[iInput] / inputScales[iInput]), -127, 127);
+            }
+            groupStart = inputGroupStart;
+            groupScales.clear();
+            for(int iGroup = 0; iGroup + 1 < groupStart.size(); iGroup++){
+                groupScales.push_back(inputScales[inputOrder[groupStart[iGroup]]] / 127);
+            }
         }
-        return 0;
-    }
-    float calc_weighted_sum(std::vector<float> prevNodeOutputs, std::vector<float> inputWeights, float bias){
-        float ans = bias;
-        assert(prevNodeOutputs.size() == inputWeights.size());
-        for(int i = 0; i < inputWeights.size(); i++){
-            ans += prevNodeOutputs[i] * inputWeights[i];
+        else{
+            groupStart = {0, numWeights};
+            groupScales = {quantize_int8(prevLayerOutputs.data(), numWeights, qInputs.data())};
         }
-        return ans;
-    }
-    void do_forward_propagation(std::vector<float> _prevLayerOutputs){
-        // Update the intermediate value(s) and output(s) of the node
-        //  based on the assumption that the node's 'input' values
-        //  like weights, bias, and previous node outputs are held constant
-        weightedSum = calc_weighted_sum(_prevLayerOutputs, inputWeights, bias);
-        outputVal = calc_act_fcn(weightedSum, activationFcn);
-    }
-    void mutate_node(int mutationRate, float prob){
-        if (std_uniform_dist(rng) < prob) bias += gen_normal_dist(rng, 0, stddevWB);
-        for(int i = 0; i < inputWeights.size(); i++){
-            if (std_uniform_dist(rng) < prob) {
-                inputWeights[i] += gen_normal_dist(rng, 0, stddevWB);
+        layerOutputs.resize(num_nodes(layerNum));
+        for(int nodeNum = 0; nodeNum < num_nodes(layerNum); nodeNum++){
+            const int8_t* pWeights = &qWeights[qLayerStart[layerNum] + nodeNum * numWeights];
+            float weightedSum = get_node_params(layerNum, nodeNum)[0];
+            for(int iGroup = 0; iGroup < groupScales.size(); iGroup++){
+                int start = groupStart[iGroup], numInGroup = groupStart[iGroup+1] - start;
+                float sumScale = groupScales[iGroup] * qWeightScales[layerNum];
+                weightedSum += sumScale * dot_int8(&qInputs[start], pWeights + start, numInGroup);
             }
+            layerOutputs[nodeNum] = calc_act_fcn(weightedSum, activationFcn);
         }
     }
-    void set_node_weights_and_biases(std::vector<int> weightsAndBiases){
+    // Run the network on the inputs of a cell. isQuantized picks do_forward_prop_1_layer_int8(...)
+    //  NOTE: This stops before the output layer, so the decisions are read from the last hidden layer
+    std::vector<float> calc_outputs(std::vector<float> layerInputs, bool isQuantized) const {
+        std::vector<float> layerOutputs;
+        for(int layerNum = 1; layerNum < num_layers() - 1; layerNum++){
+            if(isQuantized) do_forward_prop_1_layer_int8(layerInputs, layerNum, layerOutputs);
+            else do_forward_prop_1_layer(layerInputs, layerNum, layerOutputs);
+            layerInputs.swap(layerOutputs);
+        }
+        return layerInputs;
+    }
+    void set_node_weights_and_biases(int layerNum, int nodeNum, std::vector<int> weightsAndBiases){
         // Set the weights and biases to {bias, w1, w2, ...}
-        if(weightsAndBiases.size() != inputWeights.size()){
+        if(weightsAndBiases.size() != num_weights_per_node(layerNum)){
             cout << "WARNING! Size mismatch in setting the weights and biases of a node\n";
             return;
         }
-        for(int i = 0; i < inputWeights.size(); i++){
-            inputWeights[i] = weightsAndBiases[i];
+        float* pNode = get_node_params(layerNum, nodeNum);
+        for(int i = 0; i < weightsAndBiases.size(); i++){
+            pNode[1 + i] = weightsAndBiases[i];
         }
     }
-    void print_node_weights_and_biases(){
+    void print_node_weights_and_biases(int layerNum, int nodeNum) const {
         cout << "wb: ";
-        for(auto item : inputWeights) cout << item << " ";
+        const float* pNode = get_node_params(layerNum, nodeNum);
+        for(int i = 1; i <= num_weights_per_node(layerNum); i++) cout << pNode[i] << " ";
         cout << endl;
     }
-};
\ No newline at end of file
+};
+
+// How much the int8 network differs from the float network (see AI_INFERENCE_COMPARE)
+//  Both networks see the same inputs, and only the float network's decisions are used
+struct AiQuantizationReport {
+    static const int NUM_DECISION_TYPES = 6;
+    const char* DECISION_NAMES[NUM_DECISION_TYPES] = {"speedDir", "cloningDir", "speedMode", "doAttack", "doSelfDestruct", "doCloning"};
+    int64_t numDecisions = 0, numDifferentDecisions = 0;
+    int64_t numDifferent[NUM_DECISION_TYPES] = {};
+    int64_t numOutputs = 0;
+    double sumAbsError = 0;
+    float maxAbsError = 0;
+
+    void clear(){ *this = AiQuantizationReport(); }
+    void add(const std::vector<float>& outputs, const std::vector<float>& qOutputs, const CellDecision& decision, const CellDecision& qDecision){
+        assert(outputs.size() == qOutputs.size());
+        for(int i = 0; i < outputs.size(); i++){
+            float absError = abs_float(outputs[i] - qOutputs[i]);
+            sumAbsError += absError;
+            maxAbsError = max_float(maxAbsError, absError);
+        }
+        numOutputs += outputs.size();
+        bool isDifferent[NUM_DECISION_TYPES] = {
+            decision.speedDir != qDecision.speedDir, decision.cloningDirection != qDecision.cloningDirection,
+            decision.speedMode != qDecision.speedMode, decision.doAttack != qDecision.doAttack,
+            decision.doSelfDestruct != qDecision.doSelfDestruct, decision.doCloning != qDecision.doCloning
+        };
+        bool isAnyDifferent = false;
+        for(int i = 0; i < NUM_DECISION_TYPES; i++){
+            numDifferent[i] += isDifferent[i];
+            isAnyDifferent = isAnyDifferent || isDifferent[i];
+        }
+        numDifferentDecisions += isAnyDifferent;
+        numDecisions++;
+    }
+    void print(){
+        if(numDecisions == 0) return;
+        std::cout << "int8 vs float AI: " << numDifferentDecisions << " of " << numDecisions << " decisions differ ("
+            << 100.0 * numDifferentDecisions / numDecisions << "%)\n";
+        for(int i = 0; i < NUM_DECISION_TYPES; i++){
+            std::cout << "  " << DECISION_NAMES[i] << ": " << numDifferent[i] << " differ\n";
+        }
+        std::cout << "  Output error: mean " << sumAbsError / numOutputs << ", max " << maxAbsError << "\n";
+    }
+};
+AiQuantizationReport aiQuantizationReport;
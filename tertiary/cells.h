@@ -4,38 +4,381 @@
 #endif
 
 
-int count_all_alive_cells(std::vector<Cell*> pActives);
+// Live population counters. These are updated on birth, death, removal, and archetype changes
+//  so the number of cells can be read in O(1) instead of scanning pActives
+struct PopulationCounts {
+    int numAlive = 0;
+    int numDead = 0;
+    int numAliveOfType[NUM_CELL_ARCHETYPES] = {}; // Indexed by cell type (e.g. CELL_TYPE_PLANT)
+    int numDeadOfType[NUM_CELL_ARCHETYPES] = {};
+
+    void clear(){ *this = PopulationCounts(); }
+    int num_actives(){ return numAlive + numDead; }
+    int num_of_type(int cellType){ return numAliveOfType[cellType] + numDeadOfType[cellType]; }
+    void add_cell(int cellType, bool isAlive, int amt){
+        if(isAlive){ numAlive += amt; numAliveOfType[cellType] += amt; }
+        else { numDead += amt; numDeadOfType[cellType] += amt; }
+        assert(numAlive >= 0 && numDead >= 0);
+    }
+};
+PopulationCounts popCounts;
+
+// A birth requested during the interaction phase. The clone itself is only created
+//  by commit_spawn_buffers(), so pActives never grows mid-iteration
+struct SpawnRequest {
+    Cell* pParent = NULL;
+    int orderKey = -1; // Position of the parent in the serial iteration order (smaller keys commit first)
+    int cloningDir = -1;
+};
+
+// A nearby cell which touches or repels a cell
+struct Contact {
+    Cell* pOther = NULL;
+    int dX = 0, dY = 0; // Position of pOther relative to the cell (accounts for screen wrapping)
+    float dist = 0; // Distance between the centers of both cells
+    float overlap = 0; // Sum of both radii minus dist
+    int flags = 0; // CONTACT_ALIVE, CONTACT_TOUCHING, and / or CONTACT_REPELLING
+};
+// The contacts of every cell in pActives, rebuilt by update_contact_list() whenever the cells move
+//  The contacts of pActives[i] are contacts[firstContact[i]] to contacts[firstContact[i+1]-1],
+//  listed in the same order the cell would find them by searching its neighboring regions
+struct ContactList {
+    std::vector<Contact> contacts;
+    std::vector<int> firstContact = {0};
+    std::vector<int> lastVisitor; // Index of the last cell which listed each cell (skips duplicate regions)
+
+    void clear(int numCells){
+        contacts.clear();
+        firstContact.assign(1, 0);
+        lastVisitor.assign(numCells, -1);
+    }
+    ConstSpan<Contact> get_contacts(int iCell) const {
+        assert(0 <= iCell && iCell + 1 < firstContact.size());
+        return ConstSpan<Contact>(contacts.data() + firstContact[iCell], firstContact[iCell+1] - firstContact[iCell]);
+    }
+    // Append the contacts of cell iCell in another list as the next cell's contacts
+    void copy_contacts(const ContactList& other, int iCell){
+        ConstSpan<Contact> otherContacts = other.get_contacts(iCell);
+        contacts.insert(contacts.end(), otherContacts.begin(), otherContacts.end());
+        firstContact.push_back(contacts.size());
+    }
+};
+
+// Verlet-style neighbor lists for the vision queries (see Cell::get_nearest_cells(...))
+//  Each cell lists the cells within its vision distance plus a skin of VISION_LIST_SKIN pixels and reuses the list
+//  until it moves more than the skin away from where the list was built. Every cell is anchored at some position,
+//  and a cell which is born or moves more than half the skin from its anchor is re-anchored and logged as an event.
+//  A cell which is in neither the list nor the events since the list was built cannot have come into sight,
+//  so a query only has to check both to get the same cells as searching every region in sight
+//  NOTE: This is only valid right after update_vision_lists(), i.e. during the decision phase
+struct VisionLists {
+    std::vector<Cell*> pCellsByNum; // Indexed by uniqueCellNum. NULL unless the cell is in pActives
+    std::vector<int> activeCellNums; // The non-NULL entries of pCellsByNum
+    std::vector<int> movedCellNums; // The events since the generation started
+    // Starting a new generation rebuilds every list (e.g. once there are too many events to check)
+    int generation = 0;
+    int maxDia = 0; // No cell is larger during this generation
+
+    Cell* get_cell(int cellNum) const {
+        return cellNum < pCellsByNum.size() ? pCellsByNum[cellNum] : NULL;
+    }
+    void clear(){
+        pCellsByNum.clear();
+        activeCellNums.clear();
+        movedCellNums.clear();
+        generation++;
+        maxDia = 0;
+    }
+};
+
+// The cells of each region, split by what they are worth to a predator (see Cell::calc_prey_category())
+//  A cell's rank is at most its preyRankBase (see Cell::calc_prey_rank(...)), so a chasing cell goes through
+//  the categories from the most to the least valuable and skips every list which cannot beat the best cell
+//  found so far. See Cell::find_prey_in_index(...)
+//  NOTE: This is only valid during the decision phase, right after update_prey_index()
+static const int NUM_PREY_CATEGORIES = 8; // Dead or alive, times plant, worm, balanced, or predator
+// The lists of one region, indexed by category
+struct PreyLists {
+    std::vector<Cell*> cells[NUM_PREY_CATEGORIES];
+    int maxRankBases[NUM_PREY_CATEGORIES] = {}; // The largest preyRankBase in each list
+
+    int size() const {
+        int ans = 0;
+        for(int category = 0; category < NUM_PREY_CATEGORIES; category++) ans += cells[category].size();
+        return ans;
+    }
+    void clear(){
+        for(int category = 0; category < NUM_PREY_CATEGORIES; category++) cells[category].clear();
+    }
+};
+typedef RegionGrid<PreyLists> PreyIndex;
+
+// Read-only access to the rest of the world from inside Cell methods
+//  This only holds pointers, so passing it around never copies any region or list of cells
+struct WorldView {
+    const RegionGrid<std::vector<Cell*>>* pActivesRegions = NULL;
+    const ContactList* pContactList = NULL;
+    const VisionLists* pVisionLists = NULL; // If set, the vision queries use the cached lists instead of searching
+    const PreyIndex* pPreyIndex = NULL; // If set, chasing cells look for their target in it instead of searching
+    const RegionCounts* pRegionCounts = NULL; // If set, searches over many regions skip the empty blocks of regions
+
+    WorldView(const RegionGrid<std::vector<Cell*>>& _pActivesRegions, const ContactList* _pContactList = NULL)
+        : pActivesRegions(&_pActivesRegions), pContactList(_pContactList) {}
+    // Unlike pActivesRegions[reg], this never allocates a chunk of regions
+    ConstSpan<Cell*> cells_in_region(std::pair<int,int> reg) const {
+        const std::vector<Cell*>* pCells = pActivesRegions->find(reg);
+        if(pCells == NULL) return ConstSpan<Cell*>();
+        return ConstSpan<Cell*>(*pCells);
+    }
+    // Call fn({xReg, yReg}) for every region in the box which may have cells in it (see RegionCounts::for_each_region(...))
+    template <typename Func>
+    void for_each_region(int xRegLb, int numRegX, int yRegLb, int numRegY, Func fn) const {
+        if(pRegionCounts != NULL){
+            pRegionCounts->for_each_region(xRegLb, numRegX, yRegLb, numRegY, fn);
+            return;
+        }
+        for(int iX = 0; iX < numRegX; iX++){
+            for(int iY = 0; iY < numRegY; iY++) fn(std::pair<int,int>((xRegLb + iX) % cellRegionNumUbX, (yRegLb + iY) % cellRegionNumUbY));
+        }
+    }
+    ConstSpan<Contact> get_contacts(int iCell) const {
+        assert(pContactList != NULL);
+        return pContactList->get_contacts(iCell);
+    }
+};
+
+// What a cell looks like in a frame, so it can be drawn from a RenderSnapshot without touching the Cell itself
+struct CellSnapshot {
+    int posX = 0, posY = 0;
+    int dia = 0;
+    bool isAlive = true;
+    int energyPct = 0, healthPct = 0; // Keys for P_CELL_ENERGY_TEX and P_CELL_HEALTH_TEX (only used if alive)
+    bool showAttack = false, showCloning = false;
+    int EAM[NUM_EAM_ELE] = {}; // Indexed by EAM_SUN, EAM_GND, and EAM_CELLS
+    int visionDist = 0; // 0 if the vision radius is NOT drawn
+};
+std::vector<AtlasTex*> find_EAM_tex(const int EAM[NUM_EAM_ELE]){
+    std::vector<AtlasTex*> ans;
+    // First, check if everything is balanced
+    int minEAM = EAM[EAM_SUN];
+    minEAM = min_int(minEAM, EAM[EAM_GND]);
+    minEAM = min_int(minEAM, EAM[EAM_CELLS]);
+    int maxEAM = EAM[EAM_SUN];
+    maxEAM = max_int(maxEAM, EAM[EAM_GND]);
+    maxEAM = max_int(maxEAM, EAM[EAM_CELLS]);
+    if(maxEAM <= 2*minEAM){
+        ans.push_back(P_EAM_TEX["balanced"]);
+        return ans;
+    }
+    int numPixelsInEAMTex = 4;
+    int EAMPerPixel = REQ_EAM_SUM / numPixelsInEAMTex;
+    if(EAM[EAM_GND] < EAMPerPixel) ans.push_back(P_EAM_TEX["balanced"]);
+    else ans.push_back(P_EAM_TEX["g4"]); // Ground (or balanced) will fill in the empty spaces
+    // NOTE: there are 4 pixels to color in
+    // We only have to worry about the sun and predation textures, since the remaining
+    //  is already taken care of
+    if(EAM[EAM_SUN] / EAMPerPixel > 0){
+        std::string nextFile = "s" + std::to_string(EAM[EAM_SUN] / EAMPerPixel);
+        ans.push_back(P_EAM_TEX[nextFile]);
+    }
+    if(EAM[EAM_CELLS] / EAMPerPixel > 0){
+        std::string nextFile = "c" + std::to_string(EAM[EAM_CELLS] / EAMPerPixel);
+        ans.push_back(P_EAM_TEX[nextFile]);
+    }
+    return ans;
+}
+void draw_cell_snapshot(const CellSnapshot& cell){
+    int drawX = drawScaleFactor*(cell.posX + 0.5 - (float)cell.dia/2);
+    int drawY = drawScaleFactor*(cell.posY + 0.5 - (float)cell.dia/2);
+    int drawSize = drawScaleFactor*cell.dia;
+    if(!cell.isAlive){ draw_texture(pDeadCellTex, drawX, drawY, drawSize, drawSize); return; }
+    draw_texture(pCellSkeleton, drawX, drawY, drawSize, drawSize, true);
+    // Draw the health and energy on top of this
+    AtlasTex* energyTex = findSDLTex(cell.energyPct, P_CELL_ENERGY_TEX);
+    draw_texture(energyTex, drawX, drawY, drawSize, drawSize, true);
+    AtlasTex* healthTex = findSDLTex(cell.healthPct, P_CELL_HEALTH_TEX);
+    draw_texture(healthTex, drawX, drawY, drawSize, drawSize, true);
+    if(cell.showAttack)  draw_texture(pDoAttackTex,  drawX, drawY, drawSize, drawSize, true);
+    if(cell.showCloning) draw_texture(pDoCloningTex, drawX, drawY, drawSize, drawSize, true);
+    std::vector<AtlasTex*> EAM_Tex = find_EAM_tex(cell.EAM);
+    for(auto tex : EAM_Tex) draw_texture(tex, drawX, drawY, drawSize, drawSize, true);
+    if(cell.visionDist > 0){
+        int drawCenterX = drawScaleFactor*(cell.posX + 0.5);
+        int drawCenterY = drawScaleFactor*(cell.posY + 0.5);
+        int drawRadius = cell.visionDist*drawScaleFactor;
+        SDL_Color white = {0xff, 0xff, 0xff, 0x20};
+        if(drawRadius >= min_int(ubX_px, ubY_px) / 2) white = {0xff, 0xff, 0xff, 0x05};
+        draw_regular_polygon(drawCenterX, drawCenterY, drawRadius, 32, white);
+        if(drawCenterY < drawRadius)                                                draw_regular_polygon(drawCenterX         , drawCenterY + ubY_px, drawRadius, 32, white);
+        if(drawCenterY > ubY_px - drawRadius)                                       draw_regular_polygon(drawCenterX         , drawCenterY - ubY_px, drawRadius, 32, white);
+        if(drawCenterX < drawRadius && true)                                        draw_regular_polygon(drawCenterX + ubX_px, drawCenterY         , drawRadius, 32, white);
+        if(drawCenterX < drawRadius && drawCenterY < drawRadius)                    draw_regular_polygon(drawCenterX + ubX_px, drawCenterY + ubY_px, drawRadius, 32, white);
+        if(drawCenterX < drawRadius && drawCenterY > ubY_px - drawRadius)           draw_regular_polygon(drawCenterX + ubX_px, drawCenterY - ubY_px, drawRadius, 32, white);
+        if(drawCenterX > ubX_px - drawRadius && true)                               draw_regular_polygon(drawCenterX - ubX_px, drawCenterY         , drawRadius, 32, white);
+        if(drawCenterX > ubX_px - drawRadius && drawCenterY < drawRadius)           draw_regular_polygon(drawCenterX - ubX_px, drawCenterY + ubY_px, drawRadius, 32, white);
+        if(drawCenterX > ubX_px - drawRadius && drawCenterY > ubY_px - drawRadius)  draw_regular_polygon(drawCenterX - ubX_px, drawCenterY - ubY_px, drawRadius, 32, white);
+    }
+}
+
+// The stats of a new cell of the given type, before they are validated (see Cell::gen_stats_random(...))
+//  Every archetype except CELL_TYPE_GENERIC only depends on the simulation parameters, so their stats are
+//  built once and shared by every cell generated from scratch
+//  NOTE: The random draws are made for every archetype, so the sequence of random numbers stays the same either way
+GenomeRef gen_init_stats(int cellType){
+    #define stat_init(lb, ub) gen_uniform_int_dist(rng, lb, ub)
+    #define mutChance defaultMutationChance.val
+    #define mutAmt defaultMutationAmt.val
+    assert(mutChance != 0 && mutAmt != 0);
+    int attack = stat_init(1, 1), dia = stat_init(2, 2);
+    int EAM_sun = stat_init(0, 100), EAM_gnd = stat_init(0, 100), EAM_cells = stat_init(0, 100);
+    int maxHealth = stat_init(5, 5), mutationRate = stat_init(0, 0), visionDist = stat_init(2, 2);
+    // The drawn stats which an archetype keeps are part of the key, in case their ranges are ever widened
+    static std::map<std::vector<int>, GenomeRef> prototypes;
+    std::vector<int> key = {cellType, mutChance, mutAmt, attack, dia, maxHealth, mutationRate, visionDist};
+    bool isArchetype = (cellType != CELL_TYPE_GENERIC);
+    if(isArchetype && prototypes.count(key)) return prototypes[key];
+
+    GenomeRef stats;
+    // Initialize all stats
+    // Notation: Pct1k == one thousandth of the entire value
+    // {{"stat1", {val, lb, ub, mutationPct1kChance, mutationMaxPct1kChange}}, ...}
+    //  Whenever a mutation occurs, the stat must be able to change by at least 1 (unless lb == ub)
+    stats.edit("attack")         = {    attack,     0, 10000, mutChance, mutAmt}; // (0,3)
+    stats.edit("dex")            = {         0,     0,     0,         0,      0}; // TODD: Add this as an actual stat
+    stats.edit("dia")            = {       dia,     2,    10, mutChance, mutAmt}; // (2,10)
+    stats.edit("EAM_SUN")        = {   EAM_sun,     0,   100,         0,      0}; // (0,100)
+    stats.edit("EAM_GND")        = {   EAM_gnd,     0,   100,         0,      0}; // (0,100)
+    stats.edit("EAM_CELLS")      = { EAM_cells,     0,   100,         0,      0}; // (0,100)
+    stats.edit("initEnergy")     = {      1000,   500,  5000, mutChance, mutAmt}; // (0,10000)
+    stats.edit("maxAtkCooldown") = {        10,    10,    10,         0,      0}; // 10
+    stats.edit("maxEnergy")      = {  5000*dia,     1, 90000,         0,      0}; // 5000*stats["dia"]
+    stats.edit("maxHealth")      = { maxHealth,     1, 10000, mutChance, mutAmt}; // (1,10)
+    // TODO: Add stats for the AI and its relevant mutation rate
+    stats.edit("mutationRate")   = {mutationRate,   0,  1000,         0,      0}; // (0,1000)
+    // TODO: change speedIdle, speedWalk, and speedRun to a "maxSpeed" stat and change speed to a continuously varying decision
+    stats.edit("speedIdle")      = {         0,     0,     0,         0,      0}; // 0
+    stats.edit("speedWalk")      = {         1,     0,    10, mutChance, mutAmt}; // (0, 1)
+    stats.edit("speedRun")       = {         2,     0,   100, mutChance, mutAmt}; // (0, 100)
+    stats.edit("visionDist")     = {visionDist,     0,   100, mutChance, mutAmt}; // (0, 10)
+    stats.edit("rngAi_pctChanceIdle") = {   10,     0,   100,         0,      0};
+    stats.edit("rngAi_pctChanceWalk") = {   30,     0,   100,         0,      0};
+    stats.edit("rngAi_pctChanceToChangeDir") = {   5,     0,   100,         0,      0};
+    stats.edit("rngAi_pctChanceToChangeSpeed") = { 5,     0,   100,         0,      0};
+    switch(cellType){
+        case CELL_TYPE_PLANT:
+        stats.edit("attack")     = {0, 0, 0, 0, 0};
+        stats.edit("EAM_SUN")    = {100, 100, 100, 0, 0};
+        stats.edit("EAM_GND")    = {0, 0, 0, 0, 0};
+        stats.edit("EAM_CELLS")  = {0, 0, 0, 0, 0};
+        stats.edit("speedWalk")  = {0, 0, 0, 0, 0};
+        stats.edit("speedRun")   = {0, 0, 0, 0, 0};
+        stats.edit("visionDist") = {0, 0, 0, 0, 0};
+        break;
+        case CELL_TYPE_WORM:
+        stats.edit("attack")     = {0, 0, 0, 0, 0};
+        stats.edit("EAM_SUN")    = {0, 0, 0, 0, 0};
+        stats.edit("EAM_GND")    = {100, 100, 100, 0, 0};
+        stats.edit("EAM_CELLS")  = {0, 0, 0, 0, 0};
+        stats.edit("visionDist") = {0, 0, 0, 0, 0};
+        break;
+        case CELL_TYPE_PREDATOR:
+        stats.edit("EAM_SUN")    = {0, 0, 0, 0, 0};
+        stats.edit("EAM_GND")    = {0, 0, 0, 0, 0};
+        stats.edit("EAM_CELLS")  = {100, 100, 100, 0, 0};
+        break;
+        case CELL_TYPE_MUTANT:
+        stats.edit("EAM_SUN")    = {33, 33, 33, 0, 0};
+        stats.edit("EAM_GND")    = {34, 34, 34, 0, 0};
+        stats.edit("EAM_CELLS")  = {33, 33, 33, 0, 0};
+        break;
+        case CELL_TYPE_GENERIC:
+        break;
+    }
+    #undef stat_init
+    #undef mutChance
+    #undef mutAmt
+    if(isArchetype){
+        stats.intern();
+        prototypes[key] = stats;
+    }
+    return stats;
+}
+
+// Every cell is allocated here (see Cell::operator new), so sort_cell_storage() can lay them out by position
+SlotPool<Cell> cellPool;
 
 // The main (possibly only) living organisms in the simulator. Their shape will be a circle
+//  NOTE: The variables read or written by every cell in every frame (by the physics, contact search,
+//  and energy updates) are grouped at the start of the struct, so those passes touch as few cache lines
+//  as possible. The maps and vectors which are only used at birth, when mutating, or for the AI come after
 struct Cell {
+    // ---- Hot: per-frame state ----
+    // Physics, position, etc.
+    int posX = 0, posY = 0;
+    std::pair<int, int> xyRegion = {0, 0}; // Each cell should be placed in their appropriate 'bin' of nearby cells
+    // Negative values move the cell in the opposite direction
+    //  Force moves the cell in the same direction as the force, if there is enough of it
+    int forceX = 0, forceY = 0;
+
+    // State
+    int health = -1; // When this reaches 0, the cell dies
+    // Creature dies if energy <= 0.
+    //  Needed to do various abilities or keep oneself alive.
+    int energy = -1;
+    bool isAlive = true;
+    bool isAsleep = false; // Nothing near the cell changed, so its contacts were reused (see update_contact_list())
+    bool statsChanged = true; // Set by every code path which changes stats or the AI structure (see mark_stats_changed()),
+    //  so enforce_valid_cell(true) only re-validates them and updates the dependent variables when needed
+    char speedMode = IDLE_MODE; // 0 for idle, 1 for walking, 2 for running
+    int speedDir = 0; // Direction of travel in degrees
+    int iContacts = -1; // Index of this cell in pActives when the contact list was last built
+
+    // Copies of the stats read every frame, so the hot loops don't search the stats map
+    //  NOTE: These are only valid while statsChanged is false. Read them through the getters below
+    //  (e.g. get_dia()), which fall back to the stats map otherwise. See cache_hot_stats()
+    //  The types are as small as the bounds of the stats allow, so the hot section fits in one cache line
+    int size = -1; // Area (truncated at the decimal); Calculated from dia
+    int age = 0; // Relative to birth (limits lifespan)
+    int16_t hotDia = 0;
+    int16_t hotSpeed[3] = {}; // Indexed by speedMode
+    uint8_t hotEAM[NUM_EAM_ELE] = {}; // Indexed by EAM_SUN, EAM_GND, and EAM_CELLS
+
+    // ---- Cold: everything else ----
     // Identity
     Cell* pSelf = NULL; // Place a pointer to self here
     //  NOTE: The user MUST define the pointer after placing it into a vector to be permanently kept as data.
     //  Otherwise, it will be the wrong pointer.
-    Cell* pParent = NULL;
-    bool id[ID_LEN]; // An identifier which every creature "knows"
+    int parentId = -1; // uniqueCellNum of the parent (-1 if generated from scratch). See lineageLog for older ancestors
+    uint64_t id[ID_NUM_WORDS] = {}; // An identifier which every creature "knows"
     //  which may change through random mutations, but ultimately
     //  does NOT change for an individual after birth
+    //  Bit i is (id[i / 64] >> (i % 64)) & 1, and the bits at or above ID_LEN are always 0
     int uniqueCellNum = -1;
-    //  This is unique because pCellsHist never gets deleted from until the simulation ends
+    //  This is unique because it is the cell's index in lineageLog, which is only reset when the simulation restarts
 
     // Specific to a dead cell
     int timeSinceDead = -1;
     int decayRate = -1;
     int decayPeriod = -1;
 
-    // Decisions (i.e. inputs)
-    int speedDir = 0; // Direction of travel in degrees
-    char speedMode = IDLE_MODE; // 0 for idle, 1 for walking, 2 for running
+    // Decisions (i.e. inputs). speedDir and speedMode are with the hot state above
     int cloningDirection = 0; // Any number between 0 and 359 (degrees).
     //  This output selects the direction in which the cell generates its clone
     //  Anything outside that range results in a randomly selected cloning direction
     bool doAttack = false; // If this is true and the creature can to attack, it will attack
     bool doSelfDestruct = false; // Kill the creature
     bool doCloning = false; // Clone the creature
+
+    // Cached vision query (see VisionLists)
+    std::vector<int> visionList; // uniqueCellNums of the cells which were within reach when the list was built, in order
+    int visionListGeneration = -1, visionListEvent = 0; // The number of events when the list was built
+    int visionListX = 0, visionListY = 0, visionListVisionDist = 0; // Where and for which visionDist the list was built
+    int visionAnchorGeneration = -1, visionAnchorX = 0, visionAnchorY = 0;
+    // The terms of a predator's ranking which only depend on this cell (see update_prey_terms())
+    int preyRankBase = 0, preyNextX = 0, preyNextY = 0;
     
     // Creature AI (this drives the creature to make decisions)
-    std::vector<std::vector<aiNode>> aiNetwork;
+    std::shared_ptr<AiBrain> pBrain; // Clones share this until one of them changes it (see get_mutable_brain())
     // Leave the first (input) and last (output) blank
     std::vector<int> nodesPerLayer = {-1, 10, -1}; // Fill in the hidden layer (middle) values.
     // Each entry forces a decision on the frame it describes
@@ -43,61 +386,84 @@ struct Cell {
     //  The remaining entries are the decisions the cell makes
     std::vector<std::tuple<int, int,int,int,bool,bool,bool>> forcedDecisionsQueue;
 
-    // Internal timers
-    int age = 0; // Relative to birth (limits lifespan)
-    int attackCooldown = 0; // When this reaches 0, an attack can be done
-    
-    // State
-    int health = -1; // When this reaches 0, the cell dies
-    // Creature dies if energy <= 0.
-    //  Needed to do various abilities or keep oneself alive.
-    int energy = -1;
-
-    // Physics, position, etc.
-    int posX = 0, posY = 0;
-    std::pair<int, int> xyRegion = {0, 0}; // Each cell should be placed in their appropriate 'bin' of nearby cells
-    // Negative values move the cell in the opposite direction
-    //  Force moves the cell in the same direction as the force, if there is enough of it
-    int forceX = 0, forceY = 0;
-
-
     // Dependent (calculated) variables (must be updated
     //  if any of the variables they depend on are updated)
-    int size = -1; // Area (truncated at the decimal); Calculated from dia
     std::map<std::string, int> energyCostToCloneMap;
     int energyCostToClone = 0;
     std::map<std::string, int> energyCostPerUse;
     std::map<std::string, int> energyCostPerSecMap;
+    // Like the hot copies of the stats, but only read by the energy costs and the bounds checks,
+    //  which search the maps above anyway
+    int hotMaxHealth = 0, hotMaxEnergy = 0;
+    int speedEnergyCost[3] = {}; // energyCostPerUse of each speed mode, indexed by speedMode (see update_energy_costs())
     int energyCostPerFrame = 0;
-    bool isAlive = true;
+    int energyCostPerSecWithoutAge = 0; // Sum of energyCostPerSecMap except "age", which is the only cost that changes every frame
+    // Internal timers
+    int attackCooldown = 0; // When this reaches 0, an attack can be done
+    int cellType = CELL_TYPE_GENERIC; // Archetype implied by EAM (see calc_cell_type())
+    bool isCounted = false; // True while the cell is included in popCounts (i.e. while it is in pActives)
 
 
     // Stats
-    std::map<std::string, std::vector<int>> stats;
+    GenomeRef stats; // Shared with every cell which has the same stats (see genome.h)
     bool drawVisionRadius = false;
 
     // Constructor
     Cell(){}
+    static void* operator new(size_t numBytes){
+        assert(numBytes == sizeof(Cell));
+        return cellPool.alloc();
+    }
+    static void operator delete(void* pCell){ cellPool.release(pCell); }
 
     // Struct-specific methods
+    // NOTE: Call this after changing stats directly (i.e. not through a method of this struct)
+    void mark_stats_changed(){
+        statsChanged = true;
+    }
+    // Called once the stats are validated, right before statsChanged is cleared
+    void cache_hot_stats(){
+        hotDia = stats["dia"][0];
+        hotMaxHealth = stats["maxHealth"][0];
+        hotMaxEnergy = stats["maxEnergy"][0];
+        hotSpeed[IDLE_MODE] = stats["speedIdle"][0];
+        hotSpeed[WALK_MODE] = stats["speedWalk"][0];
+        hotSpeed[RUN_MODE] = stats["speedRun"][0];
+        hotEAM[EAM_SUN] = stats["EAM_SUN"][0];
+        hotEAM[EAM_GND] = stats["EAM_GND"][0];
+        hotEAM[EAM_CELLS] = stats["EAM_CELLS"][0];
+    }
+    int get_dia(){ return statsChanged ? stats["dia"][0] : hotDia; }
+    int get_max_health(){ return statsChanged ? stats["maxHealth"][0] : hotMaxHealth; }
+    int get_max_energy(){ return statsChanged ? stats["maxEnergy"][0] : hotMaxEnergy; }
+    int get_EAM(int iEAM){
+        if(!statsChanged) return hotEAM[iEAM];
+        if(iEAM == EAM_SUN) return stats["EAM_SUN"][0];
+        if(iEAM == EAM_GND) return stats["EAM_GND"][0];
+        return stats["EAM_CELLS"][0];
+    }
     void update_stat(std::string statName, int mask, int val, int lb, int ub, int mutationPct1kChance, int mutationMaxPct1kChange){
         // Default: mask == 0x1F
-        if(mask & 0x01) stats[statName][0] = val;
-        if(mask & 0x02) stats[statName][1] = lb;
-        if(mask & 0x04) stats[statName][2] = ub;
-        if(mask & 0x08) stats[statName][3] = mutationPct1kChance;
-        if(mask & 0x10) stats[statName][4] = mutationMaxPct1kChange;
+        mark_stats_changed();
+        if(mask & 0x01) stats.set(statName, 0, val);
+        if(mask & 0x02) stats.set(statName, 1, lb);
+        if(mask & 0x04) stats.set(statName, 2, ub);
+        if(mask & 0x08) stats.set(statName, 3, mutationPct1kChance);
+        if(mask & 0x10) stats.set(statName, 4, mutationMaxPct1kChange);
     }
     void mutate_stat(std::string statName){
         int mean = stats[statName][0];
         int lb = stats[statName][1], ub = stats[statName][2];
         int maxMutationAmt = (int)((long long)stats[statName][4] * (long long)stats[statName][0] / 1000);
         if(maxMutationAmt < 1) maxMutationAmt = 1;
-        stats[statName][0] = gen_uniform_int_dist(rng, max_int(lb, mean - maxMutationAmt), min_int(ub, mean + maxMutationAmt));
+        stats.set(statName, 0, gen_uniform_int_dist(rng, max_int(lb, mean - maxMutationAmt), min_int(ub, mean + maxMutationAmt)));
+        mark_stats_changed();
     }
     void mutate_stats(){
         // Random mutation based on parent's mutation rate
-        for(auto item : stats){
+        //  The record stays shared with the parent unless a stat actually changes
+        std::shared_ptr<GenomeRecord> pRecord = stats.pRecord; // Mutating may replace stats.pRecord
+        for(auto& item : pRecord->stats){
             std::string statName = item.first;
             int pct1kChanceOfMutation = stats[statName][3]; // Probability of mutation
             if(rand() % 1000 < pct1kChanceOfMutation){
@@ -107,73 +473,14 @@ struct Cell {
         }
         enforce_valid_cell(true);
     }
-    void gen_stats_random(int _cellType, std::map<std::pair<int,int>, std::vector<Cell*>>& pActivesRegions,
-    std::vector<Cell*>& pCellsHist){
+    void gen_stats_random(int _cellType, const WorldView& world){
         // Random generation from scratch
         assert(pSelf != NULL);
-
-        #define stat_init(lb, ub) gen_uniform_int_dist(rng, lb, ub)
-        #define mutChance defaultMutationChance.val
-        #define mutAmt defaultMutationAmt.val
-        assert(mutChance != 0 && mutAmt != 0);
-        // Initialize all stats
-        // Notation: Pct1k == one thousandth of the entire value
-        // {{"stat1", {val, lb, ub, mutationPct1kChance, mutationMaxPct1kChange}}, ...}
-        //  Whenever a mutation occurs, the stat must be able to change by at least 1 (unless lb == ub)
-        stats["attack"]         = { stat_init(1,   1),     0, 10000, mutChance, mutAmt}; // (0,3)
-        stats["dex"]            = {                 0,     0,     0,         0,      0}; // TODD: Add this as an actual stat
-        stats["dia"]            = { stat_init(2,   2),     2,    10, mutChance, mutAmt}; // (2,10)
-        stats["EAM_SUN"]        = { stat_init(0, 100),     0,   100,         0,      0}; // (0,100)
-        stats["EAM_GND"]        = { stat_init(0, 100),     0,   100,         0,      0}; // (0,100)
-        stats["EAM_CELLS"]      = { stat_init(0, 100),     0,   100,         0,      0}; // (0,100)
-        stats["initEnergy"]     = {              1000,   500,  5000, mutChance, mutAmt}; // (0,10000)
-        stats["maxAtkCooldown"] = {                10,    10,    10,         0,      0}; // 10
-        stats["maxEnergy"]      = { 5000*stats["dia"][0],  1, 90000,         0,      0}; // 5000*stats["dia"]
-        stats["maxHealth"]      = { stat_init(5,   5),     1, 10000, mutChance, mutAmt}; // (1,10)
-        // TODO: Add stats for the AI and its relevant mutation rate
-        stats["mutationRate"]   = { stat_init(0,   0),     0,  1000,         0,      0}; // (0,1000)
-        // TODO: change speedIdle, speedWalk, and speedRun to a "maxSpeed" stat and change speed to a continuously varying decision
-        stats["speedIdle"]      = {                 0,     0,     0,         0,      0}; // 0
-        stats["speedWalk"]      = {                 1,     0,    10, mutChance, mutAmt}; // (0, 1)
-        stats["speedRun"]       = {                 2,     0,   100, mutChance, mutAmt}; // (0, 100)
-        stats["visionDist"]     = { stat_init(2,   2),     0,   100, mutChance, mutAmt}; // (0, 10)
-        stats["rngAi_pctChanceIdle"] = {           10,     0,   100,         0,      0};
-        stats["rngAi_pctChanceWalk"] = {           30,     0,   100,         0,      0};
-        stats["rngAi_pctChanceToChangeDir"] = {     5,     0,   100,         0,      0};
-        stats["rngAi_pctChanceToChangeSpeed"] = {   5,     0,   100,         0,      0};
-        switch(_cellType){
-            case CELL_TYPE_PLANT:
-            update_stat("attack"    , 0x1F, 0, 0, 0, 0, 0);
-            update_stat("EAM_SUN"   , 0x1F, 100, 100, 100, 0, 0);
-            update_stat("EAM_GND"   , 0x1F, 0, 0, 0, 0, 0);
-            update_stat("EAM_CELLS" , 0x1F, 0, 0, 0, 0, 0);
-            update_stat("speedWalk" , 0x1F, 0, 0, 0, 0, 0);
-            update_stat("speedRun"  , 0x1F, 0, 0, 0, 0, 0);
-            update_stat("visionDist", 0x1F, 0, 0, 0, 0, 0);
-            break;
-            case CELL_TYPE_WORM:
-            update_stat("attack"    , 0x1F, 0, 0, 0, 0, 0);
-            update_stat("EAM_SUN"   , 0x1F, 0, 0, 0, 0, 0);
-            update_stat("EAM_GND"   , 0x1F, 100, 100, 100, 0, 0);
-            update_stat("EAM_CELLS" , 0x1F, 0, 0, 0, 0, 0);
-            update_stat("visionDist", 0x1F, 0, 0, 0, 0, 0);
-            break;
-            case CELL_TYPE_PREDATOR:
-            update_stat("EAM_SUN"   , 0x1F, 0, 0, 0, 0, 0);
-            update_stat("EAM_GND"   , 0x1F, 0, 0, 0, 0, 0);
-            update_stat("EAM_CELLS" , 0x1F, 100, 100, 100, 0, 0);
-            break;
-            case CELL_TYPE_MUTANT:
-            update_stat("EAM_SUN"   , 0x1F, 33, 33, 33, 0, 0);
-            update_stat("EAM_GND"   , 0x1F, 34, 34, 34, 0, 0);
-            update_stat("EAM_CELLS" , 0x1F, 33, 33, 33, 0, 0);
-            break;
-            case CELL_TYPE_GENERIC:
-            break;
-        }
-        initialize_cell(pActivesRegions, pCellsHist);
+        stats = gen_init_stats(_cellType);
+        randomize_id();
+        mark_stats_changed();
+        initialize_cell(world);
         enforce_valid_cell(true);
-        #undef stat_init
     }
     void print_stat(std::string statName, int updateMask = 0x1F){
         cout << "  " << statName << ": ";
@@ -197,20 +504,21 @@ struct Cell {
     }
     void set_int_stats(std::map<std::string, int>& varVals, int aiPreset = -1, bool _enableMutations = false,
     bool expandBounds = false){
-        // TODO: Include the ability to set the aiNetwork and nodesPerLayer
+        // TODO: Include the ability to set the AI brain and nodesPerLayer
         // Only contains functionality for the more important stats
         int lenVarVals = 0;
-        for(auto item : stats){
+        std::shared_ptr<GenomeRecord> pRecord = stats.pRecord; // Changing stats may replace stats.pRecord
+        for(auto& item : pRecord->stats){
             std::string statName = item.first;
             if(varVals.count(statName)){
                 lenVarVals++;
-                stats[statName][0] = varVals[statName];
+                stats.set(statName, 0, varVals[statName]);
                 if(expandBounds){
-                    stats[statName][1] = 0;
-                    stats[statName][2] = INT_MAX;
+                    stats.set(statName, 1, 0);
+                    stats.set(statName, 2, INT_MAX);
                 }
                 if(!_enableMutations){
-                    stats[statName][3] = 0;
+                    stats.set(statName, 3, 0);
                 }
             }
         }
@@ -229,31 +537,102 @@ struct Cell {
         assert(lenVarVals == varVals.size());
         
         // Ensure we update all dependent variables
+        mark_stats_changed();
         enforce_valid_cell(true);
     }
-    // Count alive cells only!
-    std::vector<Cell*> find_touching_cells(std::map<std::pair<int,int>, std::vector<Cell*>>& pActivesRegions){
-        std::vector<Cell*> ans;
+    // Append every cell which touches or repels this cell to contactList (see update_contact_list())
+    //  NOTE: iContacts of every cell in pActives must already be set
+    void find_contacts(const WorldView& world, ContactList& contactList){
+        assert(iContacts + 1 == contactList.firstContact.size());
+        static thread_local PointOffsets offsets;
+        int dia = get_dia();
         std::vector<std::pair<int, int>> neighboringRegions = get_neighboring_xyRegions();
-        std::set<int> checkedCells = {uniqueCellNum};
         for(auto reg : neighboringRegions){
-            for(auto pCell : pActivesRegions[reg]){
-                if(pCell->isAlive == false) continue;
-                if(checkedCells.count(pCell->uniqueCellNum)) continue;
-                if(pCell->calc_distance_from_point(posX, posY) > (float)(stats["dia"][0] + pCell->stats["dia"][0] + 0.1) / 2) continue;
-                ans.push_back(pCell);
-                checkedCells.insert(pCell->uniqueCellNum);
+            ConstSpan<Cell*> pCells = world.cells_in_region(reg);
+            calc_offsets_to_cells(pCells, offsets);
+            for(int i = 0; i < pCells.size(); i++){
+                Cell* pCell = pCells[i];
+                if(pCell == pSelf) continue;
+                if(contactList.lastVisitor[pCell->iContacts] == iContacts) continue;
+                contactList.lastVisitor[pCell->iContacts] = iContacts;
+                // The other cell's offset from pSelf (accounting for screen wrapping)
+                int dX = offsets.dXs[i], dY = offsets.dYs[i];
+                int sumOfDias = dia + pCell->get_dia();
+                // Cells this far apart can neither touch nor repel, so skip the sqrt
+                if(4 * (int64_t)offsets.sqDists[i] > (int64_t)(sumOfDias + 1) * (sumOfDias + 1)) continue;
+                float distXY = std::sqrt(offsets.sqDists[i]);
+                int flags = 0;
+                if(pCell->isAlive) flags |= CONTACT_ALIVE;
+                if(distXY <= (float)(sumOfDias + 0.1) / 2) flags |= CONTACT_TOUCHING;
+                if((int)(distXY + 0.5) < (sumOfDias + 1) / 2) flags |= CONTACT_REPELLING;
+                if((flags & (CONTACT_TOUCHING | CONTACT_REPELLING)) == 0) continue;
+                Contact contact;
+                contact.pOther = pCell;
+                contact.dX = dX; contact.dY = dY;
+                contact.dist = distXY;
+                contact.overlap = (float)sumOfDias / 2 - distXY;
+                contact.flags = flags;
+                contactList.contacts.push_back(contact);
             }
         }
+        contactList.firstContact.push_back(contactList.contacts.size());
+    }
+    // Offsets (accounting for screen wrapping) and squared distances from this cell to each cell in pCells.
+    //  The positions are gathered into contiguous arrays first so that they are all processed in one pass
+    void calc_offsets_to_cells(ConstSpan<Cell*> pCells, PointOffsets& offsets){
+        int numCells = pCells.size();
+        offsets.resize(numCells);
+        for(int i = 0; i < numCells; i++){
+            offsets.xs[i] = pCells[i]->posX;
+            offsets.ys[i] = pCells[i]->posY;
+        }
+        calc_wrapped_sq_distances(posX, posY, offsets);
+    }
+    // Count alive cells only!
+    std::vector<Cell*> find_touching_cells(const WorldView& world){
+        std::vector<Cell*> ans;
+        for(auto& contact : world.get_contacts(iContacts)){
+            if((contact.flags & (CONTACT_ALIVE | CONTACT_TOUCHING)) != (CONTACT_ALIVE | CONTACT_TOUCHING)) continue;
+            ans.push_back(contact.pOther);
+        }
         return ans;
     }
+    // The number of matching bits between both ids
     int get_id_similarity(Cell* pCellOther){
-        int ans = ID_LEN;
-        for(int i = 0; i < ID_LEN; i++){
-            if(id[i] != pCellOther->id[i]) ans--;
+        int numDifferentBits = 0;
+        for(int w = 0; w < ID_NUM_WORDS; w++) numDifferentBits += __builtin_popcountll(id[w] ^ pCellOther->id[w]);
+        return ID_LEN - numDifferentBits;
+    }
+    // Same as get_id_similarity(...) for each cell in pCells. The ids are copied into one contiguous
+    //  array first, so the XOR + popcount loop runs over plain words and can be vectorized
+    std::vector<int> get_id_similarities(const std::vector<Cell*>& pCells){
+        int numCells = pCells.size();
+        std::vector<uint64_t> otherIds(numCells * ID_NUM_WORDS);
+        for(int i = 0; i < numCells; i++){
+            for(int w = 0; w < ID_NUM_WORDS; w++) otherIds[i*ID_NUM_WORDS + w] = pCells[i]->id[w];
+        }
+        std::vector<int> ans(numCells, ID_LEN);
+        for(int i = 0; i < numCells; i++){
+            for(int w = 0; w < ID_NUM_WORDS; w++) ans[i] -= __builtin_popcountll(id[w] ^ otherIds[i*ID_NUM_WORDS + w]);
         }
         return ans;
     }
+    void randomize_id(){
+        for(int w = 0; w < ID_NUM_WORDS; w++){
+            uint64_t upperBits = rng();
+            uint64_t lowerBits = rng();
+            id[w] = (upperBits << 32) | lowerBits;
+        }
+        id[ID_NUM_WORDS-1] &= ID_LAST_WORD_MASK;
+    }
+    // Each bit flips with the same probability mutate_ai(...) uses for each node
+    void mutate_id(){
+        float prob = (float)stats["mutationRate"][0] / stats["mutationRate"][2];
+        if(prob <= 0) return;
+        for(int i = 0; i < ID_LEN; i++){
+            if(std_uniform_dist(rng) < prob) id[i / 64] ^= 1ULL << (i % 64);
+        }
+    }
     // Format: xRegLb, xRegUb, yRegLb, yRegUb
     std::tuple<int, int, int, int> get_xyRegion_neighborhoodBounds(int radiusInRegions){
         int xReg = xyRegion.first, yReg = xyRegion.second;
@@ -311,7 +690,7 @@ struct Cell {
     }
     void update_max_energy(){
         //stats["maxEnergy"][0] = 5000*size;
-        stats["maxEnergy"][0] = 1.5*energyCostToClone; // TODO: remove this setting I actually want to keep this setting after the video is published
+        stats.set("maxEnergy", 0, 1.5*energyCostToClone); // TODO: remove this setting I actually want to keep this setting after the video is published
     }
     void update_size(){
         size = PI*stats["dia"][0]*stats["dia"][0]/4 + 0.5; // size is an int
@@ -327,104 +706,146 @@ struct Cell {
     void enforce_EAM_constraints(){
         // Enforce the EAM constraints such that all elements >= 0
         //  and they add to 100
-        stats["EAM_SUN"][0] = max_int(stats["EAM_SUN"][0], 0);
-        stats["EAM_GND"][0] = max_int(stats["EAM_GND"][0], 0);
-        stats["EAM_CELLS"][0] = max_int(stats["EAM_CELLS"][0], 0);
+        stats.set("EAM_SUN", 0, max_int(stats["EAM_SUN"][0], 0));
+        stats.set("EAM_GND", 0, max_int(stats["EAM_GND"][0], 0));
+        stats.set("EAM_CELLS", 0, max_int(stats["EAM_CELLS"][0], 0));
         // Ensure that EAM_sum == EAM_SUM as defined in this struct
         int EAM_sum = calc_EAM_sum();
         if(EAM_sum != REQ_EAM_SUM) {
-            stats["EAM_SUN"][0] = stats["EAM_SUN"][0] * REQ_EAM_SUM / EAM_sum;
-            stats["EAM_GND"][0] = stats["EAM_GND"][0] * REQ_EAM_SUM / EAM_sum;
-            stats["EAM_CELLS"][0] = stats["EAM_CELLS"][0] * REQ_EAM_SUM / EAM_sum;
+            stats.set("EAM_SUN", 0, stats["EAM_SUN"][0] * REQ_EAM_SUM / EAM_sum);
+            stats.set("EAM_GND", 0, stats["EAM_GND"][0] * REQ_EAM_SUM / EAM_sum);
+            stats.set("EAM_CELLS", 0, stats["EAM_CELLS"][0] * REQ_EAM_SUM / EAM_sum);
         }
         EAM_sum = calc_EAM_sum();
         int increment = sign(REQ_EAM_SUM - calc_EAM_sum());
         while(calc_EAM_sum() != REQ_EAM_SUM){
             switch(rand() % NUM_EAM_ELE){
                 case 0:
-                stats["EAM_SUN"][0] += increment;
-                stats["EAM_SUN"][0] = saturate_int(stats["EAM_SUN"][0], stats["EAM_SUN"][1], stats["EAM_SUN"][2]);
+                stats.set("EAM_SUN", 0, saturate_int(stats["EAM_SUN"][0] + increment, stats["EAM_SUN"][1], stats["EAM_SUN"][2]));
                 break;
                 case 1:
-                stats["EAM_GND"][0] += increment;
-                stats["EAM_GND"][0] = saturate_int(stats["EAM_GND"][0], stats["EAM_GND"][1], stats["EAM_GND"][2]);
+                stats.set("EAM_GND", 0, saturate_int(stats["EAM_GND"][0] + increment, stats["EAM_GND"][1], stats["EAM_GND"][2]));
                 break;
                 case 2:
-                stats["EAM_CELLS"][0] += increment;
-                stats["EAM_CELLS"][0] = saturate_int(stats["EAM_CELLS"][0], stats["EAM_CELLS"][1], stats["EAM_CELLS"][2]);
+                stats.set("EAM_CELLS", 0, saturate_int(stats["EAM_CELLS"][0] + increment, stats["EAM_CELLS"][1], stats["EAM_CELLS"][2]));
                 break;
             }
         }
         assert(calc_EAM_sum() == REQ_EAM_SUM);
     }
+    int calc_cell_type(){
+        if(stats["EAM_SUN"][0] == 100) return CELL_TYPE_PLANT;
+        if(stats["EAM_GND"][0] == 100) return CELL_TYPE_WORM;
+        if(stats["EAM_CELLS"][0] == 100) return CELL_TYPE_PREDATOR;
+        if(stats["EAM_SUN"][0] >= 30 && stats["EAM_GND"][0] >= 30 && stats["EAM_CELLS"][0] >= 30) return CELL_TYPE_MUTANT;
+        return CELL_TYPE_GENERIC;
+    }
+    // The archetype to specialize this cell's decisions for (see decide_next_frame<CELL_TYPE>(...)).
+    //  cellType is only up to date while statsChanged is false
+    int get_kernel_type(){ return statsChanged ? CELL_TYPE_GENERIC : cellType; }
+    // Keep popCounts correct if EAM changes the archetype of a cell which is already counted
+    void update_cell_type(){
+        int newCellType = calc_cell_type();
+        if(newCellType == cellType) return;
+        if(isCounted){
+            popCounts.add_cell(cellType, isAlive, -1);
+            popCounts.add_cell(newCellType, isAlive, 1);
+        }
+        cellType = newCellType;
+    }
+    // Hash of everything a clone inherits (the id, the stats, and the AI)
+    uint64_t calc_genome_hash(){
+        uint64_t hash = hash_bytes(id, sizeof(id));
+        for(auto& item : stats){
+            hash = hash_bytes(item.first.data(), item.first.size(), hash);
+            hash = hash_bytes(item.second.data(), item.second.size() * sizeof(int), hash);
+        }
+        if(pBrain != NULL) hash = hash_bytes(pBrain->params.data(), pBrain->params.size() * sizeof(float), hash);
+        return hash;
+    }
+    // Append this cell to lineageLog. Call this once the cell is fully created
+    void record_birth(){
+        assert(uniqueCellNum == lineageLog.next_id());
+        LineageRecord record;
+        record.id = uniqueCellNum;
+        record.parentId = parentId;
+        record.birthFrame = frameNum;
+        record.archetype = cellType;
+        record.genomeHash = calc_genome_hash();
+        lineageLog.append(record);
+    }
+    // Call these when the cell is added to or removed from pActives
+    void register_population(){
+        assert(!isCounted);
+        isCounted = true;
+        popCounts.add_cell(cellType, isAlive, 1);
+    }
+    void unregister_population(){
+        if(!isCounted) return;
+        isCounted = false;
+        popCounts.add_cell(cellType, isAlive, -1);
+    }
     void enforce_bounds(int& val, int lb, int ub){
         assert(lb <= ub);
         val = saturate_int(val, lb, ub);
     }
     // Only consider the nearest cells within the cell's field of view
-    //  Return the cell ids starting with the cells most relevant to predators
-    //  Used to return std::vector<Cell*>
-    std::vector<int> get_nearest_cell_ids(int maxNumCellsToReturn,
-    std::map<std::pair<int,int>, std::vector<Cell*>>& pActivesRegions,
-    std::vector<Cell*> pCellsHist){
-        // visionDist: The distance the cell can see
-        int xReg = xyRegion.first, yReg = xyRegion.second;
-        
+    //  Return the cells starting with the cells most relevant to predators
+    //  Used to return the cell ids
+    // The box of regions (xRegLb, xRegUb, yRegLb, yRegUb) in which the cells within the cell's field of view appear
+    std::tuple<int, int, int, int> get_vision_region_bounds(){
         // A region counts as too far if it its nearest point is out of range
         //      NOTE: Assume that a cell's diameter is smaller than the size of each cell region
         //      NOTE: Also, some regions may be larger than CELL_REGION_SIDE_LEN
         float maxDetectableCellDistance = (float)stats["visionDist"][0] + CELL_REGION_SIDE_LEN; //(float)stats["dia"][2] / 2;
         int visionDist_NumReg = maxDetectableCellDistance / CELL_REGION_SIDE_LEN;
-
+        return get_xyRegion_neighborhoodBounds(visionDist_NumReg);
+    }
+    std::vector<Cell*> get_nearest_cells(int maxNumCellsToReturn, const WorldView& world){
+        // visionDist: The distance the cell can see
         // Get the rectangular box in which all relevant regions appear
-        std::tuple<int, int, int, int> xyRegionNeighborhoodBounds = get_xyRegion_neighborhoodBounds(visionDist_NumReg);
+        std::tuple<int, int, int, int> xyRegionNeighborhoodBounds = get_vision_region_bounds();
         int xRegLb = std::get<0>(xyRegionNeighborhoodBounds);
         int xRegUb = std::get<1>(xyRegionNeighborhoodBounds);
         int yRegLb = std::get<2>(xyRegionNeighborhoodBounds);
         int yRegUb = std::get<3>(xyRegionNeighborhoodBounds);
         //if(stats["EAM_CELLS"][0] == 100) cout << endl;
-        //if(stats["EAM_CELLS"][0] == 100) print_scalar_vals("xRegLb", xRegLb, "xRegUb", xRegUb, "yRegLb", yRegLb, "yRegUb", yRegUb, "radiusInRegions", visionDist_NumReg);
+        //if(stats["EAM_CELLS"][0] == 100) print_scalar_vals("xRegLb", xRegLb, "xRegUb", xRegUb, "yRegLb", yRegLb, "yRegUb", yRegUb);
+        int numRegX = (xRegUb - xRegLb + cellRegionNumUbX) % cellRegionNumUbX + 1;
+        int numRegY = (yRegUb - yRegLb + cellRegionNumUbY) % cellRegionNumUbY + 1;
         
-        // Go through all the regions within visionDist from the current cell
-        #define add_nearby_cells_to_distance_map(pCellVec){ \
-            for(auto pCell : pCellVec){ \
-                if(pCell == pSelf) continue; \
-                int cellId = pCell->uniqueCellNum; \
-                if(nearbyCellDistances.count(cellId) > 0) continue; \
-                float distXY = calc_distance_from_point(pCell->posX, pCell->posY); \
-                float distToTravel = max_float(distXY - (float)stats["dia"][0]/2 - (float)pCell->stats["dia"][0]/2, 0); \
-                float effectiveVisionRadius = stats["visionDist"][0] + (float)pCell->stats["dia"][0]/2; \
-                if(false) print_scalar_vals("cellId", cellId, "posX", pCell->posX, "posY", pCell->posY, "distXY", distXY, "distToTravel", distToTravel, "effectiveVisionRadius", effectiveVisionRadius); \
-                if(distXY <= effectiveVisionRadius) nearbyCellDistances[cellId] = distToTravel; \
-                if(false && distXY <= effectiveVisionRadius) cout << "  added cellId " << cellId << " to the list of nearby cell distances\n"; \
-            } \
-        }
-        #define increment_iX_or_iY(iX, iY){ \
-            iX++; \
-            if(iX == xRegUb + 1){ \
-                iX = xRegLb; iY++; \
-                if(iY == yRegUb + 1) break; \
-            } \
-            iX %= cellRegionNumUbX; \
-            iY %= cellRegionNumUbY; \
-        }
-        std::map<int, float> nearbyCellDistances;
-        //xRegLb = 0; yRegLb = 0; xRegUb = cellRegionNumUbX - 1; yRegUb = cellRegionNumUbY - 1; // DEBUG: Just to get all the regions
-        //print_scalar_vals("xRegLb", xRegLb, "yRegLb", yRegLb, "xRegUb", xRegUb, "yRegUb", yRegUb);
-        int iX = xRegLb, iY = yRegLb;
-        while(true){
-            // Search the alive and dead cells in the region and map their cell ids to their distance from the current cell
-            std::pair<int, int> pReg = {iX, iY};
-            add_nearby_cells_to_distance_map(pActivesRegions[pReg]);
-            increment_iX_or_iY(iX, iY);
+        // Every cell which may be in sight, sorted by cell id
+        static thread_local std::vector<Cell*> pCandidates;
+        pCandidates.clear();
+        if(world.pVisionLists != NULL){
+            get_vision_list_candidates(*world.pVisionLists, world, pCandidates);
+        } else {
+            // Go through all the regions within visionDist from the current cell
+            //  Each cell is in exactly one region, so no cell is added twice
+            world.for_each_region(xRegLb, numRegX, yRegLb, numRegY, [&](std::pair<int,int> reg){
+                ConstSpan<Cell*> pCells = world.cells_in_region(reg);
+                pCandidates.insert(pCandidates.end(), pCells.begin(), pCells.end());
+            });
+            std::sort(pCandidates.begin(), pCandidates.end(), [](Cell* pLeft, Cell* pRight){ return pLeft->uniqueCellNum < pRight->uniqueCellNum; });
         }
 
-        // Transfer nearbyCellDistances to a vector
-        std::vector<std::pair<int, float>> nearbyCellDistancesVec;
-        for(auto ele : nearbyCellDistances){
-            int cellId = ele.first;
-            float distXY = ele.second;
-            nearbyCellDistancesVec.push_back({cellId, distXY});
+        // Map the alive and dead cells in sight to their distance from the current cell
+        //  Cells which are clearly out of sight are rejected by their squared distance, so only visible cells need a sqrt
+        //  NOTE: Cached candidates may lie outside the regions a full search would have gone through, so they are skipped too
+        static thread_local PointOffsets offsets;
+        calc_offsets_to_cells(pCandidates, offsets);
+        std::vector<std::pair<Cell*, float>> nearbyCellDistancesVec; // Sorted by cell id
+        for(int i = 0; i < pCandidates.size(); i++){
+            Cell* pCell = pCandidates[i];
+            if(pCell == pSelf) continue;
+            if((pCell->xyRegion.first - xRegLb + cellRegionNumUbX) % cellRegionNumUbX >= numRegX) continue;
+            if((pCell->xyRegion.second - yRegLb + cellRegionNumUbY) % cellRegionNumUbY >= numRegY) continue;
+            float effectiveVisionRadius = stats["visionDist"][0] + (float)pCell->stats["dia"][0]/2;
+            if(offsets.sqDists[i] > ((double)effectiveVisionRadius + 1) * ((double)effectiveVisionRadius + 1)) continue;
+            float distXY = std::sqrt(offsets.sqDists[i]);
+            float distToTravel = max_float(distXY - (float)stats["dia"][0]/2 - (float)pCell->stats["dia"][0]/2, 0);
+            if(false) print_scalar_vals("cellId", pCell->uniqueCellNum, "posX", pCell->posX, "posY", pCell->posY, "distXY", distXY, "distToTravel", distToTravel, "effectiveVisionRadius", effectiveVisionRadius);
+            if(distXY <= effectiveVisionRadius) nearbyCellDistancesVec.push_back({pCell, distToTravel});
         }
 
         // Sort this based on their distances from the current cell
@@ -436,25 +857,79 @@ struct Cell {
             }
         );
 
-        // Add the first few closest cells' unique ids to the list to be returned
+        // Add the first few closest cells to the list to be returned
         //  (don't return more than the specified upper limit)
-        std::vector<int> nearestCellIds;
+        std::vector<Cell*> nearestCells;
         std::vector<float> nearestDistXY;
         for(int i = 0; i < min_int(nearbyCellDistancesVec.size(), maxNumCellsToReturn); i++){
-            int cellId = nearbyCellDistancesVec[i].first;
-            nearestCellIds.push_back(cellId);
+            nearestCells.push_back(nearbyCellDistancesVec[i].first);
             float distXY = nearbyCellDistancesVec[i].second;
             nearestDistXY.push_back(distXY);
         }
-        //if(nearestCellIds.size() > 0 && stats["EAM_CELLS"][0] == 100){
-        //    print_1d_vec("  nearestCellIds", nearestCellIds);
+        //if(nearestCells.size() > 0 && stats["EAM_CELLS"][0] == 100){
+        //    print_cell_coords(nearestCells);
         //    print_1d_vec("  nearestDistXY" , nearestDistXY );
         //}
-        return nearestCellIds;
+        return nearestCells;
+    }
+    // The cells which may be in sight according to the cell's vision list, sorted by cell id (see VisionLists)
+    //  The list is rebuilt first if it cannot be trusted anymore
+    void get_vision_list_candidates(const VisionLists& lists, const WorldView& world, std::vector<Cell*>& pCandidates){
+        int visionDist = stats["visionDist"][0];
+        int numNewEvents = lists.movedCellNums.size() - visionListEvent;
+        int dX = wrap_offset(posX - visionListX, WRAP_AROUND_X ? ubX.val : 0);
+        int dY = wrap_offset(posY - visionListY, WRAP_AROUND_Y ? ubY.val : 0);
+        bool isValid = visionListGeneration == lists.generation && visionListVisionDist == visionDist;
+        isValid = isValid && dX*dX + dY*dY <= VISION_LIST_SKIN * VISION_LIST_SKIN;
+        // Checking many events costs more than searching again
+        isValid = isValid && numNewEvents <= visionList.size() + 16;
+        if(!isValid){
+            build_vision_list(lists, world, visionDist);
+            numNewEvents = 0;
+        }
+        for(int cellNum : visionList){
+            Cell* pCell = lists.get_cell(cellNum);
+            if(pCell != NULL) pCandidates.push_back(pCell);
+        }
+        if(numNewEvents == 0) return;
+        for(int i = visionListEvent; i < lists.movedCellNums.size(); i++){
+            Cell* pCell = lists.get_cell(lists.movedCellNums[i]);
+            if(pCell != NULL) pCandidates.push_back(pCell);
+        }
+        // A cell which moved may be in the list already, or have moved more than once
+        std::sort(pCandidates.begin(), pCandidates.end(), [](Cell* pLeft, Cell* pRight){ return pLeft->uniqueCellNum < pRight->uniqueCellNum; });
+        pCandidates.erase(std::unique(pCandidates.begin(), pCandidates.end()), pCandidates.end());
+    }
+    // List every cell which is close enough that it may come into sight before the list has to be rebuilt
+    //  The cell may move by VISION_LIST_SKIN and every other cell by up to VISION_LIST_SKIN from here
+    //  (i.e. half the skin on each side of its anchor) without being logged as an event
+    void build_vision_list(const VisionLists& lists, const WorldView& world, int visionDist){
+        static thread_local PointOffsets offsets;
+        int reach = visionDist + (lists.maxDia + 1) / 2 + 2 * VISION_LIST_SKIN + 1;
+        int64_t sqReach = (int64_t)reach * reach;
+        // Every region within reach. A region can be larger than CELL_REGION_SIDE_LEN, but never smaller
+        std::tuple<int, int, int, int> bounds = get_xyRegion_neighborhoodBounds(reach / CELL_REGION_SIDE_LEN + 1);
+        int xRegLb = std::get<0>(bounds), xRegUb = std::get<1>(bounds);
+        int yRegLb = std::get<2>(bounds), yRegUb = std::get<3>(bounds);
+        int numRegX = (xRegUb - xRegLb + cellRegionNumUbX) % cellRegionNumUbX + 1;
+        int numRegY = (yRegUb - yRegLb + cellRegionNumUbY) % cellRegionNumUbY + 1;
+        visionList.clear();
+        world.for_each_region(xRegLb, numRegX, yRegLb, numRegY, [&](std::pair<int,int> reg){
+            ConstSpan<Cell*> pCells = world.cells_in_region(reg);
+            calc_offsets_to_cells(pCells, offsets);
+            for(int i = 0; i < pCells.size(); i++){
+                if(pCells[i] != pSelf && offsets.sqDists[i] <= sqReach) visionList.push_back(pCells[i]->uniqueCellNum);
+            }
+        });
+        std::sort(visionList.begin(), visionList.end());
+        visionListGeneration = lists.generation;
+        visionListEvent = lists.movedCellNums.size();
+        visionListX = posX;
+        visionListY = posY;
+        visionListVisionDist = visionDist;
     }
     // NOTE: This function also determines what the AI inputs are
-    std::vector<float> get_ai_inputs(std::map<std::pair<int,int>, std::vector<Cell*>>& pActivesRegions,
-    std::vector<Cell*> pCellsHist){
+    std::vector<float> get_ai_inputs(const WorldView& world){
         std::vector<float> aiInputs;
         int _numAiInputs = 0;
         #define add_to_neural_net(aiInputs, property, _numAiInputs) {aiInputs.push_back(property); _numAiInputs++;}
@@ -471,19 +946,18 @@ struct Cell {
         //  (a) Find out which 100 cells are closest
         //  (b) For now, we just care about their id similarity
         int maxNumCellsSeen = 10;
-        #define get_pCell(cellId) pCellsHist[cellId]
-        std::vector<int> nearestCellIds = get_nearest_cell_ids(maxNumCellsSeen, pActivesRegions, pCellsHist);
+        std::vector<Cell*> nearestCells = get_nearest_cells(maxNumCellsSeen, world);
+        std::vector<int> idSimilarities = get_id_similarities(nearestCells);
         for(int i = 0; i < maxNumCellsSeen; i++){
             float ageOther = 0, attackCooldownOther = 0;
             float healthOther = 0, energyOther = 0;
             float idSimilarity = 0;
             float relDist = 0, relDirOther = 0, relSpeedRadial = 0, relSpeedTangential = 0;
-            if(i < nearestCellIds.size()){
-                int cellId = nearestCellIds[i];
-                Cell* pCell = get_pCell(cellId);
+            if(i < nearestCells.size()){
+                Cell* pCell = nearestCells[i];
                 ageOther = pCell->age; attackCooldownOther = pCell->attackCooldown;
                 healthOther = pCell->health; energyOther = pCell->energy;
-                idSimilarity = get_id_similarity(pCell);
+                idSimilarity = idSimilarities[i];
                 relDist = calc_distance_from_point(pCell->posX, pCell->posY);
                 // Standard angle of linepointing from other cell to current cell
                 relDirOther = (pCell->speedDir + 180) % 360; // degrees
@@ -511,9 +985,30 @@ struct Cell {
         else assert(aiInputs.size() == nodesPerLayer[0]);
         assert(_numAiInputs == nodesPerLayer[0]);
 
-        #undef get_pCell
         return aiInputs;
     }
+    // The typical magnitude of each input of get_ai_inputs(...), in the same order, taken from this cell's stats,
+    //  their bounds, and the size of the map. The int8 AI divides the inputs by these (see AiBrain::inputScales)
+    //  NOTE: These are fixed when the brain is made, and any input beyond its scale saturates
+    std::vector<float> get_ai_input_scales(){
+        float ageScale = 1000; // Nothing bounds the age, but the energy it costs grows as age^2
+        float attackCooldownScale = stats["maxAtkCooldown"][2];
+        float healthScale = get_max_health();
+        // maxEnergy is far above what most cells ever store, which is within a few times their initial energy
+        float energyScale = min_int(get_max_energy(), 4 * stats["initEnergy"][0]);
+        float forceScale = stats["dia"][2];
+        float distScale = min_float(stats["visionDist"][0] + 2 * CELL_REGION_SIDE_LEN, max_int(ubX.val, ubY.val));
+        float speedScale = max_int(stats["speedRun"][2], 1);
+        std::vector<float> aiInputScales = {ageScale, attackCooldownScale, healthScale, energyScale, forceScale, forceScale};
+        int maxNumCellsSeen = 10;
+        for(int i = 0; i < maxNumCellsSeen; i++){
+            std::vector<float> otherCellScales = {ageScale, attackCooldownScale, healthScale, energyScale,
+                (float)ID_LEN, distScale, 360, speedScale, speedScale};
+            aiInputScales.insert(aiInputScales.end(), otherCellScales.begin(), otherCellScales.end());
+        }
+        assert(aiInputScales.size() == nodesPerLayer[0]);
+        return aiInputScales;
+    }
     void set_ai_outputs(int _speedDir, int _cloningDirection, int _speedMode,
     bool _doAttack, bool _doSelfDestruct, bool _doCloning){
         int _numAiOutputs = 0;
@@ -544,6 +1039,16 @@ struct Cell {
         }
         return {intVec, boolVec};
     }
+    CellDecision get_decision(){
+        CellDecision decision;
+        decision.speedDir = speedDir;
+        decision.cloningDirection = cloningDirection;
+        decision.speedMode = speedMode;
+        decision.doAttack = doAttack;
+        decision.doSelfDestruct = doSelfDestruct;
+        decision.doCloning = doCloning;
+        return decision;
+    }
     void update_energy_costs(){
         // Note: For stats and variables that never change, I only need to update this once
         if(!isAlive){ energyCostPerFrame = 0; return; }
@@ -556,44 +1061,48 @@ struct Cell {
         else energyCostToCloneMap["attack"] = 0;
         energyCostToCloneMap["size"] = StrExprInt::solve(ENERGY_COST_TO_CLONE["size"], {{"x", size}, {"size", size}});
         for(auto item : energyCostToCloneMap) energyCostToClone += item.second;
-        stats["maxEnergy"][0] = 1.5 * energyCostToClone; // TODO: remove this line I actually want to keep this setting after the video is published
+        stats.set("maxEnergy", 0, 1.5 * energyCostToClone); // TODO: remove this line I actually want to keep this setting after the video is published
 
         // Surviving (per second)
-        energyCostPerFrame = 0;
         energyCostPerSecMap["base"] =         StrExprInt::solve(ENERGY_COST_PER_USE["base"], {{"x", -1}, {"size", size}});
         energyCostPerSecMap["visionDist"] =   StrExprInt::solve(ENERGY_COST_PER_USE["visionDist"], {{"x", stats["visionDist"][0]}, {"size", size}});
         energyCostPerSecMap["maxHealth"] =    StrExprInt::solve(ENERGY_COST_PER_USE["maxHealth"], {{"x", stats["maxHealth"][0]}, {"size", size}});
-        energyCostPerSecMap["age"] = StrExprInt::solve(ENERGY_COST_PER_USE["age"], {{"x", age}, {"size", size}});
-        for(auto item : energyCostPerSecMap) energyCostPerFrame += item.second;
-        energyCostPerFrame /= TICKS_PER_SEC;
+        energyCostPerSecWithoutAge = 0;
+        for(auto item : energyCostPerSecMap){
+            if(item.first != "age") energyCostPerSecWithoutAge += item.second;
+        }
+        update_age_energy_cost();
 
         // Surviving (per frame) and using abilities
         energyCostPerUse["speedRun"] = StrExprInt::solve(ENERGY_COST_PER_USE["speed"],  {{"x", stats["speedRun"][0]}, {"size", size}});
         energyCostPerUse["speedWalk"] = StrExprInt::solve(ENERGY_COST_PER_USE["speed"], {{"x", stats["speedWalk"][0]}, {"size", size}});
         energyCostPerUse["speedIdle"] = StrExprInt::solve(ENERGY_COST_PER_USE["speed"], {{"x", stats["speedIdle"][0]}, {"size", size}});
         energyCostPerUse["attack"] = StrExprInt::solve(ENERGY_COST_PER_USE["attack"],   {{"x", stats["attack"][0]}, {"size", size}});
+        speedEnergyCost[IDLE_MODE] = energyCostPerUse["speedIdle"];
+        speedEnergyCost[WALK_MODE] = energyCostPerUse["speedWalk"];
+        speedEnergyCost[RUN_MODE] = energyCostPerUse["speedRun"];
+    }
+    // Unlike the other energy costs, this one depends on age, so it is recalculated every frame
+    void update_age_energy_cost(){
+        energyCostPerSecMap["age"] = StrExprInt::solve(ENERGY_COST_PER_USE["age"], {{"x", age}, {"size", size}});
+        energyCostPerFrame = (energyCostPerSecWithoutAge + energyCostPerSecMap["age"]) / TICKS_PER_SEC;
     }
     void consume_energy_per_frame(){
         if(!isAlive) return;
-        update_energy_costs();
+        if(statsChanged) update_energy_costs();
+        else update_age_energy_cost();
         energy -= energyCostPerFrame;
-        if(speedMode == IDLE_MODE) energy -= energyCostPerUse["speedIdle"] / TICKS_PER_SEC;
-        if(speedMode == WALK_MODE) energy -= energyCostPerUse["speedWalk"] / TICKS_PER_SEC;
-        if(speedMode == RUN_MODE)  energy -= energyCostPerUse["speedRun"] / TICKS_PER_SEC;
+        if(speedMode == IDLE_MODE || speedMode == WALK_MODE || speedMode == RUN_MODE) energy -= speedEnergyCost[(int)speedMode] / TICKS_PER_SEC;
     }
     void enforce_valid_ai(){
         enforce_valid_ai_structure();
         enforce_valid_ai_inputs();
     }
     void enforce_valid_ai_structure(){
-        if(aiNetwork.size() != nodesPerLayer.size() - 1) print_scalar_vals("aiNetwork.size()", aiNetwork.size(), "nodesPerLayer.size()", nodesPerLayer.size());
-        assert(aiNetwork.size() == nodesPerLayer.size() - 1);
+        assert(pBrain != NULL);
+        if(pBrain->nodesPerLayer != nodesPerLayer) print_scalar_vals("pBrain->num_layers()", pBrain->num_layers(), "nodesPerLayer.size()", nodesPerLayer.size());
+        assert(pBrain->nodesPerLayer == nodesPerLayer);
         for(auto num : nodesPerLayer) assert(0 < num);
-        for(int layerNum = 1; layerNum < aiNetwork.size(); layerNum++){
-            assert(aiNetwork[layerNum-1].size() == nodesPerLayer[layerNum]);
-            //  aiNetwork[layerNum-1].size() is the number of nodes in layerNum,
-            //  where layer 0 is the input layer
-        }
     }
     void enforce_valid_ai_inputs(){
         // Cell Inputs
@@ -611,28 +1120,34 @@ struct Cell {
         assert(uniqueCellNum >= 0);
 
         // Cell State
-        enforce_bounds(health, 0, stats["maxHealth"][0]);
-        enforce_bounds(energy, 0, stats["maxEnergy"][0]);
+        enforce_bounds(health, 0, get_max_health());
+        enforce_bounds(energy, 0, get_max_energy());
 
         enforce_valid_ai_inputs();
 
         // Physics, position, etc.
         enforce_valid_xyPos();
 
-        // Stats
-        if(enforceStats){
-            for(auto item : stats){
+        // Stats (skipped if nothing changed them since they were last validated)
+        if(enforceStats && statsChanged){
+            std::shared_ptr<GenomeRecord> pRecord = stats.pRecord; // Changing stats may replace stats.pRecord
+            for(auto& item : pRecord->stats){
                 std::string statName = item.first;
                 int lb = stats[statName][1], ub = stats[statName][2];
-                enforce_bounds(stats[statName][0], lb, ub);
+                assert(lb <= ub);
+                stats.set(statName, 0, saturate_int(stats[statName][0], lb, ub));
             }
-            enforce_bounds(stats["initEnergy"][0], 0, stats["maxEnergy"][0]);
-            stats["speedWalk"][0] = max_int(stats["speedIdle"][0], stats["speedWalk"][0]);
-            stats["speedRun"][0]  = max_int(stats["speedWalk"][0], stats["speedRun"][0] );
+            stats.set("initEnergy", 0, saturate_int(stats["initEnergy"][0], 0, stats["maxEnergy"][0]));
+            stats.set("speedWalk", 0, max_int(stats["speedIdle"][0], stats["speedWalk"][0]));
+            stats.set("speedRun", 0, max_int(stats["speedWalk"][0], stats["speedRun"][0]));
             update_size();
             enforce_EAM_constraints();
+            update_cell_type();
             enforce_valid_ai();
             update_energy_costs();
+            cache_hot_stats();
+            stats.intern();
+            statsChanged = false;
         }
         
 
@@ -648,14 +1163,13 @@ struct Cell {
             if(timeSinceDead < 0) timeSinceDead = 0;
         }
     }
-    void initialize_cell(std::map<std::pair<int,int>, std::vector<Cell*>>& pActivesRegions,
-    std::vector<Cell*>& pCellsHist){
+    void initialize_cell(const WorldView& world){
         assert(pSelf != NULL);
         age = 0;
         attackCooldown = stats["maxAtkCooldown"][0];
         energy = stats["initEnergy"][0];
         health = stats["maxHealth"][0];
-        if(pParent == NULL) init_ai(pActivesRegions, pCellsHist);
+        if(parentId < 0) init_ai(world);
         // Sort out initial decisions
         if(aiMode == RNG_BASED_AI_MODE){
             //force_decision(1, 0, 0, IDLE_MODE, doAttack, false, doCloning);
@@ -676,22 +1190,25 @@ struct Cell {
     }
     // TODO: Create a function to set the weights of the AI (partially done)
     void apply_ai_preset(int aiPreset = -1){
-        //aiNode node = aiNetwork[layer][nodeNum];
         int numWeightsPerNode;
         std::vector<int> nodeWeightsAndBiases; // {bias, w1, ..., wLast}
         int layer, node, i;
         switch(aiPreset){
             case 0:
-            for(layer = 0; layer < aiNetwork.size(); layer++){
-                for(node = 0; node < aiNetwork[layer].size(); node++){
+            {
+            AiBrain& brain = get_mutable_brain();
+            for(layer = 1; layer < brain.num_layers(); layer++){
+                for(node = 0; node < brain.num_nodes(layer); node++){
                     nodeWeightsAndBiases.clear();
-                    numWeightsPerNode = aiNetwork[layer][node].inputWeights.size();
+                    numWeightsPerNode = brain.num_weights_per_node(layer);
                     for(i = 0; i < numWeightsPerNode; i++){
                         nodeWeightsAndBiases.push_back(0);
                     }
-                    aiNetwork[layer][node].set_node_weights_and_biases(nodeWeightsAndBiases);
+                    brain.set_node_weights_and_biases(layer, node, nodeWeightsAndBiases);
                 }
             }
+            brain.quantize();
+            }
             break;
 
             default:
@@ -699,35 +1216,24 @@ struct Cell {
         }
 
     }
-    void init_ai(std::map<std::pair<int,int>, std::vector<Cell*>>& pActivesRegions,
-    std::vector<Cell*>& pCellsHist){
+    void init_ai(const WorldView& world){
         // NOTE: Do NOT use this function until all the inputs are initialized
-        std::vector<float> aiInputs = get_ai_inputs(pActivesRegions, pCellsHist);
+        mark_stats_changed(); // The AI structure needs to be validated again
+        std::vector<float> aiInputs = get_ai_inputs(world);
         std::tuple<std::vector<int>, std::vector<bool>> aiOutputs = get_ai_outputs();
 
         // Start with the (first) hidden layer, doing more of them if needed
         for(int i = 1; i < nodesPerLayer.size(); i++){
             assert(0 < nodesPerLayer[i] && nodesPerLayer[i] < 1000);
         }
-        for(int layerNum = 1; layerNum < nodesPerLayer.size(); layerNum++){
-            std::vector<aiNode> layerNodes;
-            for(int nodeNum = 0; nodeNum < nodesPerLayer[layerNum]; nodeNum++){
-                aiNode nextNode;
-                nextNode.init_node(1000 * layerNum + nodeNum, false, nodesPerLayer[layerNum - 1]);
-                layerNodes.push_back(nextNode);
-            }
-            aiNetwork.push_back(layerNodes);
-        }
+        pBrain = std::make_shared<AiBrain>();
+        pBrain->init_brain(nodesPerLayer, get_ai_input_scales());
     }
-    std::vector<float> do_forward_prop_1_layer(std::vector<float> layerInputs, int layerNum){
-        // layerNum == 0 means the input layer
-        std::vector<float> ans;
-        for(int nodeNum = 0; nodeNum < aiNetwork[layerNum-1].size(); nodeNum++){
-            aiNetwork[layerNum-1][nodeNum].do_forward_propagation(layerInputs);
-            ans.push_back(aiNetwork[layerNum-1][nodeNum].outputVal);
-        }
-        assert(ans.size() == nodesPerLayer[layerNum]);
-        return ans;
+    // Call this before changing the brain. If any other cell shares it, this cell gets its own copy first
+    AiBrain& get_mutable_brain(){
+        assert(pBrain != NULL);
+        if(pBrain.use_count() > 1) pBrain = std::make_shared<AiBrain>(*pBrain);
+        return *pBrain;
     }
     void update_timers(){
         if(isAlive) age++;
@@ -744,9 +1250,20 @@ struct Cell {
     void clear_forced_decisions(){
         forcedDecisionsQueue.clear();
     }
+    // Make a recorded decision (see decisionLog) instead of asking the ai
+    //  Mirrors decide_next_frame(...), which only validates the cell on some paths
+    void replay_decision(const CellDecision& decision){
+        update_timers();
+        set_ai_outputs(decision.speedDir, decision.cloningDirection, decision.speedMode,
+            decision.doAttack, decision.doSelfDestruct, decision.doCloning);
+        if(!isAlive || decision.clampedState) enforce_valid_cell(false);
+    }
     // To override the ai, append an entry to forcedDecisionsQueue
-    void decide_next_frame(std::map<std::pair<int,int>, std::vector<Cell*>>& pActivesRegions,
-    std::vector<Cell*>& pCellsHist){
+    // CELL_TYPE is the archetype the decision is specialized for (see get_kernel_type()). With the RNG-based AI,
+    //  plants stay put without looking around, worms wander without looking or attacking, and predators always
+    //  look for prey. CELL_TYPE_GENERIC checks the stats instead, so it works for every cell (e.g. mutants)
+    template <int CELL_TYPE = CELL_TYPE_GENERIC>
+    void decide_next_frame(const WorldView& world){
         // Modify the values the creature can directly control based on the ai
         //  i.e. the creature decides what to do based on this function
         int _speedDir = speedDir, _cloningDir = cloningDirection, _speedMode = speedMode;
@@ -780,18 +1297,15 @@ struct Cell {
 
         if(aiMode == EVOLUTIONARY_NEURAL_NETWORK_AI_MODE){
             // If the AI is free to decide, then decide what to do
-            std::vector<float> layerInputs = get_ai_inputs(pActivesRegions, pCellsHist);
-            for(int layerNum = 1; layerNum < aiNetwork.size(); layerNum++){
-                layerInputs = do_forward_prop_1_layer(layerInputs, layerNum);
+            std::vector<float> aiInputs = get_ai_inputs(world);
+            std::vector<float> aiOutputs = pBrain->calc_outputs(aiInputs, aiInferenceMode == AI_INFERENCE_INT8);
+            CellDecision decision = calc_ai_decision(aiOutputs);
+            if(aiInferenceMode == AI_INFERENCE_COMPARE){
+                std::vector<float> qAiOutputs = pBrain->calc_outputs(aiInputs, true);
+                aiQuantizationReport.add(aiOutputs, qAiOutputs, decision, calc_ai_decision(qAiOutputs));
             }
-            _speedDir = saturate_int((int)layerInputs[0], 0, 359);
-            _cloningDir = saturate_int((int)layerInputs[2], 0, 359);
-            _speedMode = (char)saturate_int((char)layerInputs[3], IDLE_MODE, RUN_MODE);
-            _doAttack = (layerInputs[4] >= 0 && enableAutomaticAttack && attackCooldown == 0);
-            _doSelfDestruct = (layerInputs[5] >= 1 && enableAutomaticSelfDestruct); // If this condition is too easy to trigger, then cells die too easily
-            _doCloning = (layerInputs[6] >= 0 && enableAutomaticCloning);
-            //print_scalar_vals("3 _speedMode", _speedMode);
-            set_ai_outputs(_speedDir, _cloningDir, _speedMode, _doAttack, _doSelfDestruct, _doCloning);
+            //print_scalar_vals("3 _speedMode", decision.speedMode);
+            set_ai_outputs(decision.speedDir, decision.cloningDirection, decision.speedMode, decision.doAttack, decision.doSelfDestruct, decision.doCloning);
             return;
         }
         
@@ -800,73 +1314,104 @@ struct Cell {
             _doAttack = enableAutomaticAttack && attackCooldown == 0;
             _doSelfDestruct = enableAutomaticSelfDestruct;
             _doCloning = enableAutomaticCloning;
-            if(stats["EAM_SUN"][0] == 100){
+            // NOTE: _cloningDir is drawn by every archetype, so specializing never changes the random sequence
+            bool isPlant = (CELL_TYPE == CELL_TYPE_PLANT), isWorm = (CELL_TYPE == CELL_TYPE_WORM);
+            if constexpr(CELL_TYPE == CELL_TYPE_GENERIC){
+                isPlant = (get_EAM(EAM_SUN) == 100);
+                isWorm = (get_EAM(EAM_GND) == 100);
+            }
+            if(isPlant){
                 set_ai_outputs(0, rand() % 360, IDLE_MODE, false, false, _doCloning);
                 return;
             }
-            if(stats["EAM_GND"][0] == 100){
+            if(isWorm){
                 do_random_cell_activity(5, 5, false, _doCloning);
                 return;
             }
-            std::vector<int> nearestCellIds = get_nearest_cell_ids(100, pActivesRegions, pCellsHist);
-            if(nearestCellIds.size() == 0){
+            Cell* pTarget = NULL;
+            if(world.pPreyIndex == NULL || !find_prey_in_index(100, world, pTarget)){
+                pTarget = find_optimal_prey(get_nearest_cells(100, world), world.pPreyIndex != NULL);
+            }
+            if(pTarget == NULL){
                 do_random_cell_activity(5, 5, _doAttack, _doCloning);
                 return;
             }
-            chase_optimal_cell(pCellsHist, nearestCellIds, _doAttack, false, _doCloning);
+            chase_optimal_cell(pTarget, _doAttack, false, _doCloning);
             return;
         }
     }
+    // What the neural network decides, given its outputs (see AiBrain::calc_outputs(...))
+    CellDecision calc_ai_decision(const std::vector<float>& aiOutputs){
+        CellDecision decision;
+        decision.speedDir = saturate_int((int)aiOutputs[0], 0, 359);
+        decision.cloningDirection = saturate_int((int)aiOutputs[2], 0, 359);
+        decision.speedMode = (char)saturate_int((char)aiOutputs[3], IDLE_MODE, RUN_MODE);
+        decision.doAttack = (aiOutputs[4] >= 0 && enableAutomaticAttack && attackCooldown == 0);
+        decision.doSelfDestruct = (aiOutputs[5] >= 1 && enableAutomaticSelfDestruct); // If this condition is too easy to trigger, then cells die too easily
+        decision.doCloning = (aiOutputs[6] >= 0 && enableAutomaticCloning);
+        return decision;
+    }
     void mutate_ai(){
+        // The brain is only copied once a bias or weight actually changes
+        //  NOTE: Every parameter draws from rng whether it changes or not, so sharing never changes the random sequence
         float prob = (float)stats["mutationRate"][0] / stats["mutationRate"][2];
-        for(int i = 0; i < aiNetwork.size(); i++){
-            for(int j = 0; j < aiNetwork[i].size(); j++){
-                aiNetwork[i][j].mutate_node(stats["mutationRate"][0], prob);
+        int numParams = pBrain->params.size();
+        bool isMutated = false;
+        for(int i = 0; i < numParams; i++){
+            if(std_uniform_dist(rng) < prob){
+                get_mutable_brain().params[i] += gen_normal_dist(rng, 0, pBrain->stddevWB);
+                isMutated = true;
             }
         }
+        if(isMutated) pBrain->quantize();
         enforce_valid_ai();
     }
     // Define the identity of the cell (in relation to the rest of the simulator)
-    void define_self(int _cellNum, Cell* _pSelf, Cell* _pParent){
+    void define_self(int _cellNum, Cell* _pSelf, int _parentId = -1){
         // NOTE: If I push a copy of the cell into a new location, I need to update the new cell's identity
         pSelf = _pSelf;
-        pParent = _pParent;
+        parentId = _parentId;
         uniqueCellNum = _cellNum;
+        isCounted = false; // A copied cell is NOT counted until it registers itself
+        iContacts = -1; // Nor is it in the contact list until it is rebuilt
+        visionList.clear(); // Nor does it have a vision list or an anchor yet
+        visionListGeneration = -1;
+        visionAnchorGeneration = -1;
     }
     void set_initEnergy(int val, bool setEnergy = true){
-        stats["initEnergy"][0] = val;
+        stats.set("initEnergy", 0, val);
+        mark_stats_changed(); // e.g. energyCostToClone depends on it
         if(setEnergy) energy = stats["initEnergy"][0];
     }
     // NOTE: The full energy accumulation can only be done after this function is applied to every cell
     //  in the local area.
     // This function causes cells to accumulate energy from the sun, ground, and dead cells.
     //  Also, energy loss due to overcrowding leads is applied by this function
-    void do_energy_transfer(std::map<std::pair<int,int>, std::vector<Cell*>>& pActivesRegions){
+    void do_energy_transfer(const WorldView& world){
         if(!isAlive) return;
         //cout << "  energy: " << energy << " ----> ";
         // Energy from the sun
         //  First, calculate which cells are touching the current cell
-        std::vector<Cell*> touchingCells = find_touching_cells(pActivesRegions);
-        for(int i = touchingCells.size()-1; i >= 0; i--){
-            // Dead cells don't affect energy transfer here
-            if(touchingCells[i]->isAlive == false) touchingCells.erase(touchingCells.begin() + i);
-        }
+        //  NOTE: Dead cells don't affect energy transfer here, so find_touching_cells(...) leaves them out
+        std::vector<Cell*> touchingCells = find_touching_cells(world);
         //  TODO: Give each cell a dexterity (dex) stat, which will help them NOT be blocked by other cells.
         //  Bigger cells get more of the energy and will receive most of the energy if competing with smaller cells.
         int sumOfCellSizes = size;
         for(auto cell : touchingCells) sumOfCellSizes += cell->size;
-        energy += (float)energyFromSunPerSec * stats["EAM_SUN"][0] * size / 100 / sumOfCellSizes;
+        energy += (float)energyFromSunPerSec * get_EAM(EAM_SUN) * size / 100 / sumOfCellSizes;
         
         // Energy from the ground -> Energy may be shared between cells,
         //  so it is better to add a pointer to the cell to each applicable ground cell's
         //  list of cells to which it will distribute energy
         enforce_valid_xyPos();
-        if(simGndEnergy[posY][posX] < stats["EAM_GND"][0]){
-            energy += simGndEnergy[posY][posX];
-            simGndEnergy[posY][posX] = 0;
+        int EAM_gnd = get_EAM(EAM_GND);
+        int gndEnergy = simGndEnergy.get(posX, posY);
+        if(gndEnergy < EAM_gnd){
+            energy += gndEnergy;
+            simGndEnergy.set(posX, posY, 0);
         } else {
-            energy += stats["EAM_GND"][0];
-            simGndEnergy[posY][posX] -= stats["EAM_GND"][0];
+            energy += EAM_gnd;
+            simGndEnergy.set(posX, posY, gndEnergy - EAM_gnd);
         }
         
         // Energy from cells which just died -> Add a pointer to the cell to the list
@@ -880,25 +1425,22 @@ struct Cell {
             {"x", sumOfCellSizes-size}, {"size", size}});
 
         // Enforce energy constraints
-        energy = min_int(energy, stats["maxEnergy"][0]);
+        energy = min_int(energy, get_max_energy());
         enforce_valid_cell(false);
         //cout << energy << endl;
     }
     // The dead cells and ground transfer energy to the living cells and / or the environment
-    void do_energy_decay(std::map<std::pair<int,int>, std::vector<Cell*>>& pActivesRegions){
+    void do_energy_decay(const WorldView& world){
         // Alive cells don't decay
         if(isAlive) return;
         // Energy to cells which are touching the dead cell
-        std::vector<Cell*> touchingCells = find_touching_cells(pActivesRegions);
-        for(int i = touchingCells.size()-1; i >= 0; i--){
-            // Remove dead cells from this list, as they don't receive any of the energy
-            if(touchingCells[i]->isAlive == false) touchingCells.erase(touchingCells.begin() + i);
-        }
+        //  NOTE: Dead cells don't receive any of the energy, so find_touching_cells(...) leaves them out
+        std::vector<Cell*> touchingCells = find_touching_cells(world);
         // Calculate the amount of energy to give to other cells
         int rmEnergy = 0; // Energy to give to other cells
         std::vector<int> energyWeight(touchingCells.size());
         for(int i = 0; i < energyWeight.size(); i++){
-            energyWeight[i] = touchingCells[i]->stats["EAM_CELLS"][0] * (energy + 200) / 1000;
+            energyWeight[i] = touchingCells[i]->get_EAM(EAM_CELLS) * (energy + 200) / 1000;
             rmEnergy += energyWeight[i];
         }
         // Ensure only the dead cell's total amount of energy can be given away at most 
@@ -906,7 +1448,7 @@ struct Cell {
             float multiplyBy = (float)energy / (float)rmEnergy;
             for(int i = 0; i < touchingCells.size(); i++){
                 Cell* pCell = touchingCells[i];
-                pCell->energy += multiplyBy * energyWeight[i] * pCell->stats["EAM_CELLS"][0] / 100;
+                pCell->energy += multiplyBy * energyWeight[i] * pCell->get_EAM(EAM_CELLS) / 100;
             }
             energy = 0;
             enforce_valid_cell(false);
@@ -929,7 +1471,7 @@ struct Cell {
         rmEnergy = 0;
         int _efficiencyPct = 0; // TODO: Ensure this is non-zero after the first video is published
         if(timeSinceDead % decayPeriod == 0) rmEnergy = decayRate * energy / 100 + 20;
-        simGndEnergy[posY][posX] = min_int(maxGndEnergy.val, simGndEnergy[posY][posX] + rmEnergy * _efficiencyPct / 100);
+        simGndEnergy.set(posX, posY, min_int(maxGndEnergy.val, simGndEnergy.get(posX, posY) + rmEnergy * _efficiencyPct / 100));
         energy -= rmEnergy;
         //print_scalar_vals("  decayed energy", rmEnergy, "decayRate", decayRate, "decayPeriod", decayPeriod, "timeSinceDead", timeSinceDead, "Remaining energy", energy);
 
@@ -942,9 +1484,19 @@ struct Cell {
         posY = gen_uniform_int_dist(rng, _lbY, _ubY);
         enforce_valid_xyPos();
     }
-    Cell* clone_self(int cellNum, std::map<std::pair<int,int>, std::vector<Cell*>>& pActivesRegions,
-    std::vector<Cell*>& pCellsHist, std::vector<Cell*>& pActives,
-    int targetCloningDir = -1, bool randomizeCloningDir = false, bool doMutation = true){
+    // Pay for a clone now, but defer creating it until the spawn buffers are committed
+    void request_clone(std::vector<SpawnRequest>& spawnBuffer, int orderKey, int targetCloningDir = -1){
+        assert(pSelf != NULL && isAlive);
+        energy -= energyCostToClone;
+        SpawnRequest request;
+        request.pParent = pSelf;
+        request.orderKey = orderKey;
+        request.cloningDir = targetCloningDir;
+        spawnBuffer.push_back(request);
+    }
+    // NOTE: Set chargeCloningCost to false if the energy was already paid by request_clone(...)
+    Cell* clone_self(int cellNum, RegionGrid<std::vector<Cell*>>& pActivesRegions, std::vector<Cell*>& pActives,
+    int targetCloningDir = -1, bool randomizeCloningDir = false, bool doMutation = true, bool chargeCloningCost = true){
         // The clone's position will be roughly the cell's diameter plus 1 away from the cell
         //Cell* pClone = new Cell(cellNum, CELL_TYPE_GENERIC, pAlivesRegions, pSelf);
         assert(pSelf != NULL);
@@ -953,15 +1505,14 @@ struct Cell {
             print_scalar_vals("frameNum", frameNum);
             assert(pSelf->isAlive);
         }
-        energy -= energyCostToClone; //energy -= pSelf->energyCostToClone;
+        if(chargeCloningCost) energy -= energyCostToClone; //energy -= pSelf->energyCostToClone;
 
         // Cloning the cell
         Cell* pClone = new Cell();
-        pCellsHist.push_back(pClone);
         pActives.push_back(pClone);
         *pClone = *pSelf; // Almost all quantities should be copied over perfectly
-        pClone->define_self(cellNum, pClone, pSelf);
-        pClone->initialize_cell(pActivesRegions, pCellsHist);
+        pClone->define_self(cellNum, pClone, uniqueCellNum);
+        pClone->initialize_cell(WorldView(pActivesRegions));
         assert(uniqueCellNum != pClone->uniqueCellNum);
 
         // Update the new cell's position and determine the cloning direction
@@ -975,17 +1526,23 @@ struct Cell {
         pClone->update_pos(posX + cloningRadius*cos_deg(cloningDirection), posY + cloningRadius*sin_deg(cloningDirection));
 
         // Possible mutations
-        if(doMutation) pClone->mutate_stats();
+        if(doMutation){
+            pClone->mutate_stats();
+            pClone->mutate_id();
+        }
         pClone->health = stats["maxHealth"][0];
         pClone->energy = stats["initEnergy"][0];
         pClone->enforce_valid_cell(true);
+        pClone->register_population();
+        pClone->record_birth();
 
         return pClone;
     }
     void print_id(){
-        std::cout << "id: "; for(bool b : id) std::cout << b; std::cout << std::endl;
+        std::cout << "id: "; for(int i = 0; i < ID_LEN; i++) std::cout << ((id[i / 64] >> (i % 64)) & 1); std::cout << std::endl;
     }
     int get_speed(){
+        if(!statsChanged && (speedMode == IDLE_MODE || speedMode == WALK_MODE || speedMode == RUN_MODE)) return hotSpeed[(int)speedMode];
         switch(speedMode){
             case IDLE_MODE:
             return stats["speedIdle"][0];
@@ -1032,55 +1589,38 @@ struct Cell {
         increment_pos(_speed * cos_deg(speedDir), _speed * sin_deg(speedDir));
         enforce_valid_xyPos();
     }
-    void update_forces(std::map<std::pair<int,int>, std::vector<Cell*>>& pActivesRegions){
+    void update_forces(const WorldView& world){
         // Dead cells aren't affected by force
         if(!isAlive) return;
 
-        // First, calculate which cells are nearby
-        std::vector<std::pair<int, int>> neighboringRegions = get_neighboring_xyRegions();
-
-        // Check each nearby cell for any forces
+        // Check each nearby cell for any forces (the contact list already accounts for screen wrapping)
         // TODO: apply a force due to nonliving objects and walls, if applicable
-        for(auto reg : neighboringRegions){
-            for(auto pCell : pActivesRegions[reg]){
-                if(pCell->isAlive == false) continue;
-                if(pCell == pSelf) continue;
-                // Calculate the other cell's distance from pSelf (account for screen wrapping)
-                int dX = pCell->posX - posX, dY = pCell->posY - posY;
-                assert(WRAP_AROUND_X && WRAP_AROUND_Y);
-                if (WRAP_AROUND_X) {
-                    int dX2 = (ubX.val - abs(dX)) * -sign(dX); // Result has opposite sign vs dX
-                    dX = (abs(dX) < abs(dX2) ? dX : dX2);
-                }
-                if (WRAP_AROUND_Y) {
-                    int dY2 = (ubY.val - abs(dY)) * -sign(dY); // Result has opposite sign vs dX
-                    dY = (abs(dY) < abs(dY2) ? dY : dY2);
-                }
-                int dist = sqrt(dX*dX + dY*dY) + 0.5;
-                int targetDist = (pCell->stats["dia"][0] + stats["dia"][0] + 1) / 2; 
-                if (dist < targetDist) {
-                    // apply repulsive force based on the square of the differential distance
-                    int forceMagnitude = 10*(targetDist - dist)*(targetDist - dist);
-                    // Get the x and y components forceX and forceY
-                    if (dist == 0) {
-                        // Set the force direction randomly
-                        int forceDirection = gen_uniform_int_dist(rng, 0, 359);
-                        forceX += forceMagnitude * cos_deg(forceDirection);
-                        forceY += forceMagnitude * sin_deg(forceDirection);
-                    } else if (dX == 0 || dY == 0) {
-                        int force_dX = forceMagnitude * -sign(dX); //(dX < 0 ? 1 : -1);
-                        int force_dY = forceMagnitude * -sign(dY);
-                        forceX += force_dX;
-                        forceY += force_dY;
-                    } else {
-                        // dX != 0, dY != 0
-                        float dY_div_dX = (dY / dX);
-                        int force_dX = forceMagnitude / sqrt( 1 + dY_div_dX * dY_div_dX ) * -sign(dY); //(dX < 0 ? 1 : -1);
-                        int force_dY = force_dX * dY_div_dX;
-                        forceX += force_dX;
-                        forceY += force_dY;
-                    }
-                }
+        for(auto& contact : world.get_contacts(iContacts)){
+            if((contact.flags & (CONTACT_ALIVE | CONTACT_REPELLING)) != (CONTACT_ALIVE | CONTACT_REPELLING)) continue;
+            Cell* pCell = contact.pOther;
+            int dX = contact.dX, dY = contact.dY;
+            int dist = contact.dist + 0.5;
+            int targetDist = (pCell->get_dia() + get_dia() + 1) / 2; 
+            // apply repulsive force based on the square of the differential distance
+            int forceMagnitude = 10*(targetDist - dist)*(targetDist - dist);
+            // Get the x and y components forceX and forceY
+            if (dist == 0) {
+                // Set the force direction randomly
+                int forceDirection = gen_uniform_int_dist(rng, 0, 359);
+                forceX += forceMagnitude * cos_deg(forceDirection);
+                forceY += forceMagnitude * sin_deg(forceDirection);
+            } else if (dX == 0 || dY == 0) {
+                int force_dX = forceMagnitude * -sign(dX); //(dX < 0 ? 1 : -1);
+                int force_dY = forceMagnitude * -sign(dY);
+                forceX += force_dX;
+                forceY += force_dY;
+            } else {
+                // dX != 0, dY != 0
+                float dY_div_dX = (dY / dX);
+                int force_dX = forceMagnitude / sqrt( 1 + dY_div_dX * dY_div_dX ) * -sign(dY); //(dX < 0 ? 1 : -1);
+                int force_dY = force_dX * dY_div_dX;
+                forceX += force_dX;
+                forceY += force_dY;
             }
         }
         return;
@@ -1120,27 +1660,13 @@ struct Cell {
     }
     int calc_distX_from_point(int xCoord){
         // Assume -ubX.val < posX && posx < 2*ubX.val
-        if(!WRAP_AROUND_X) return xCoord - posX;
         // The shortest path may involve warping between x = 0 and x = ubX.val-1
-        std::vector<int> dxPossibilities = {xCoord - posX, xCoord - posX + ubX.val, xCoord - posX - ubX.val};
-        int dx = xCoord - posX;
-        for(auto val : dxPossibilities){
-            if(abs(dx) > abs(val)) dx = val;
-        }
-        //if(uniqueCellNum == 0) cout << "dx: " << dx << endl;
-        return dx;
+        return wrap_offset(xCoord - posX, WRAP_AROUND_X ? ubX.val : 0);
     }
     int calc_distY_from_point(int yCoord){
         // Assume -ubY.val < posY && posY < 2*ubY.val
-        if(!WRAP_AROUND_Y) return yCoord - posY;
         // The shortest path may involve warping between y = 0 and y = ubY.val-1
-        std::vector<int> dyPossibilities = {yCoord - posY, yCoord - posY + ubY.val, yCoord - posY - ubY.val};
-        int dy = yCoord - posY;
-        for(auto val : dyPossibilities){
-            if(abs(dy) > abs(val)) dy = val;
-        }
-        //if(uniqueCellNum == 0) cout << "dy: " << dy << endl;
-        return dy;
+        return wrap_offset(yCoord - posY, WRAP_AROUND_Y ? ubY.val : 0);
     }
     float calc_distance_from_point(int xCoord, int yCoord){
         // Screen wrapping applies, if set that way in the simulation
@@ -1155,36 +1681,23 @@ struct Cell {
         energy -= energyCostPerUse["attack"];
         enforce_valid_cell(false);
     }
-    void apply_non_movement_decisions(std::vector<Cell*>& pActives, std::vector<Cell*>& pCellsHist,
-    std::map<std::pair<int,int>, std::vector<Cell*>>& pActivesRegions){
+    // Births are only recorded into spawnBuffer here (see commit_spawn_buffers())
+    //  numPendingSpawns: The number of births already requested this phase
+    void apply_non_movement_decisions(std::vector<SpawnRequest>& spawnBuffer, int orderKey, int numPendingSpawns,
+    const WorldView& world){
 
         if(doAttack && attackCooldown == 0 && energy > energyCostPerUse["attack"]){
-            // Find out which regions neighbor the cell's region
-            std::vector<std::pair<int, int>> neighboringRegions = get_neighboring_xyRegions();
-            
             // Damage all cells that this cell touches excluding the cell itself
+            //  (the contact list never includes the cell itself or the same cell twice)
             // If health < 0, the cell will die when the death conditions are checked
-            std::set<int> attackedCellNums;
-            for(auto reg : neighboringRegions){
-                for(auto pCell : pActivesRegions[reg]){
-                    if(pCell->isAlive == false) continue;
-                    if(uniqueCellNum == pCell->uniqueCellNum) continue;
-                    if(attackedCellNums.count(pCell->uniqueCellNum)) continue;
-                    float distXY = calc_distance_from_point(pCell->posX, pCell->posY);
-                    float distanceThreshold = (stats["dia"][0] + pCell->stats["dia"][0] + 0.1) / 2;
-                    //print_scalar_vals("distXY", distXY, "distanceThreshold", distanceThreshold);
-                    if(distXY <= distanceThreshold){
-                        attack_cell(pCell);
-                        //forcedDecisionsQueue.insert(forcedDecisionsQueue.begin(), {1, speedDir, cloningDirection, speedMode, doAttack, doSelfDestruct, doCloning});
-                        attackedCellNums.insert(pCell->uniqueCellNum);
-                    }
-                }
+            for(auto& contact : world.get_contacts(iContacts)){
+                if((contact.flags & (CONTACT_ALIVE | CONTACT_TOUCHING)) != (CONTACT_ALIVE | CONTACT_TOUCHING)) continue;
+                attack_cell(contact.pOther);
+                //forcedDecisionsQueue.insert(forcedDecisionsQueue.begin(), {1, speedDir, cloningDirection, speedMode, doAttack, doSelfDestruct, doCloning});
             }
-            //print_scalar_vals("attackedCellNums.size()", attackedCellNums.size());
         }
-        int numAliveCells = count_all_alive_cells(pActives);
-        if(doCloning && energy > 1.2*energyCostToClone && pActives.size() < cellLimit.val){
-            Cell* pCell = clone_self(pCellsHist.size(), pActivesRegions, pCellsHist, pActives, cloningDirection);
+        if(doCloning && energy > 1.2*energyCostToClone && popCounts.num_actives() + numPendingSpawns < cellLimit.val){
+            request_clone(spawnBuffer, orderKey, cloningDirection);
         }
         enforce_valid_cell(true);
     }
@@ -1307,57 +1820,128 @@ struct Cell {
         force_decision(1, optimalDir, rand() % 360, _speedMode, _enableAttack, false, _enableCloning);
         preplan_shortest_path_to_point(nextPosX, nextPosY, targetX, targetY, enableRunning, _enableAttack, _enableCloning);
     }
-    // Modify each decision
-    void chase_optimal_cell(std::vector<Cell*> pCellsHist,
-    std::vector<int>& nearestCellIds, bool _doAttack, bool _doSelfDestruct, bool _doCloning){
-        //clear_forced_decisions();
-        #define get_pCell(cellId) pCellsHist[cellId];
-
-        // First, mark each cell with a number and record the largest (best) number
-        std::vector<int> cellRanks;
-        for(auto cellId : nearestCellIds){
-            Cell* pCell = get_pCell(cellId);
-            int rank = 0;
-            int deadCoef = 16000, plantCoef = 8000, gndCoef = 4000, balancedCoef = 2000, predatorCoef = 1000;
-            int speedCoef = -10, distanceCoef = -1, doAttackCoef = 0;
-
-            // Assume the dead cell hasn't moved since dying
-            if(pCell->isAlive == false) assert(pCell->speedMode == IDLE_MODE);
-            int xNext = pCell->posX + pCell->get_speed()*cos_deg(pCell->speedDir);
-            int yNext = pCell->posY + pCell->get_speed()*sin_deg(pCell->speedDir);
-            int distance = calc_distance_from_point(xNext, yNext);
-            int optimalSpeedDir = get_optimal_speedDir_to_point(xNext, yNext);
-            int speedDirDiff = min_int(abs(optimalSpeedDir - speedDir), abs(optimalSpeedDir - speedDir - 360));
-
-            // Update Rank
-            rank += deadCoef * !(pCell->isAlive);
-            rank += plantCoef * (pCell->stats["EAM_SUN"][0] == 100);
-            rank += gndCoef * (pCell->stats["EAM_GND"][0] == 100);
-            rank += balancedCoef * (pCell->stats["EAM_SUN"][0] < 100 && pCell->stats["EAM_GND"][0] < 100 && pCell->stats["EAM_CELLS"][0] < 100);
-            rank += predatorCoef * (pCell->stats["EAM_CELLS"][0] == 100);
-            rank += speedCoef * pCell->get_speed();
-            rank += distanceCoef * distance;
-            //rank += dirCoef * speedDirDiff / 180;
-            rank += doAttackCoef * pCell->doAttack;
-            cellRanks.push_back(rank);
+    // What this cell is worth to a predator, before its speed and distance are accounted for
+    int calc_prey_category_coef(){
+        int deadCoef = 16000, plantCoef = 8000, gndCoef = 4000, balancedCoef = 2000, predatorCoef = 1000;
+        int EAM_sun = get_EAM(EAM_SUN), EAM_gnd = get_EAM(EAM_GND), EAM_cells = get_EAM(EAM_CELLS);
+        int coef = deadCoef * !isAlive;
+        coef += plantCoef * (EAM_sun == 100);
+        coef += gndCoef * (EAM_gnd == 100);
+        coef += balancedCoef * (EAM_sun < 100 && EAM_gnd < 100 && EAM_cells < 100);
+        coef += predatorCoef * (EAM_cells == 100);
+        return coef;
+    }
+    // The list of PreyIndex this cell belongs to. Lower categories are worth more
+    int calc_prey_category(){
+        int kind = 2; // Balanced
+        if(get_EAM(EAM_SUN) == 100) kind = 0;
+        else if(get_EAM(EAM_GND) == 100) kind = 1;
+        else if(get_EAM(EAM_CELLS) == 100) kind = 3;
+        return (isAlive ? 4 : 0) + kind;
+    }
+    // The part of a predator's ranking which only depends on this cell (see calc_prey_rank(...)). Each cell does this
+    //  once per frame instead of every predator which sees it doing it again
+    //  NOTE: Call this again whenever the cell's speed or direction changes, e.g. after it decides
+    void update_prey_terms(){
+        int speedCoef = -10;
+        // Assume the dead cell hasn't moved since dying
+        if(isAlive == false) assert(speedMode == IDLE_MODE);
+        preyNextX = posX + get_speed()*cos_deg(speedDir);
+        preyNextY = posY + get_speed()*sin_deg(speedDir);
+        preyRankBase = calc_prey_category_coef() + speedCoef * get_speed();
+    }
+    // The larger, the better pPrey is to chase. Its prey terms must be up to date
+    int calc_prey_rank(Cell* pPrey){
+        int distance = calc_distance_from_point(pPrey->preyNextX, pPrey->preyNextY);
+        return pPrey->preyRankBase - distance;
+    }
+    // The best cell to chase among nearestCells (see get_nearest_cells(...)), or NULL if there is none
+    //  The first of the best cells wins, i.e. the nearest one
+    //  areTermsUpdated: The prey terms of every cell are up to date already (i.e. PreyIndex is in use)
+    Cell* find_optimal_prey(const std::vector<Cell*>& nearestCells, bool areTermsUpdated = false){
+        Cell* pTarget = NULL;
+        int maxRank = 0;
+        for(auto pCell : nearestCells){
+            if(!areTermsUpdated) pCell->update_prey_terms();
+            int rank = calc_prey_rank(pCell);
+            if(pTarget == NULL || rank > maxRank){
+                pTarget = pCell;
+                maxRank = rank;
+            }
         }
-        int maxRank = cellRanks[0];
-        for(auto rank : cellRanks) maxRank = max_int(maxRank, rank);
-        for(int i = cellRanks.size()-1; i >= 0; i--){
-            if(cellRanks[i] != maxRank) nearestCellIds.erase(nearestCellIds.begin() + i);
+        return pTarget;
+    }
+    // Same as find_optimal_prey(get_nearest_cells(maxNumCells, world)), but only ranks the cells of the categories
+    //  which can still beat the best cell found so far (see PreyIndex)
+    //  Returns false if the index cannot tell which cell get_nearest_cells(...) would have put first,
+    //  i.e. if it could have left some cells out or if the best cells are equally far away
+    bool find_prey_in_index(int maxNumCells, const WorldView& world, Cell*& pTarget){
+        const PreyIndex& index = *world.pPreyIndex;
+        std::tuple<int, int, int, int> bounds = get_vision_region_bounds();
+        int xRegLb = std::get<0>(bounds), xRegUb = std::get<1>(bounds);
+        int yRegLb = std::get<2>(bounds), yRegUb = std::get<3>(bounds);
+        int numRegX = (xRegUb - xRegLb + cellRegionNumUbX) % cellRegionNumUbX + 1;
+        int numRegY = (yRegUb - yRegLb + cellRegionNumUbY) % cellRegionNumUbY + 1;
+        static thread_local std::vector<const PreyLists*> pRegionLists;
+        pRegionLists.clear();
+        int numCellsInRegions = 0;
+        // The index holds the same cells as the regions (so the same blocks of regions are empty), and which of the
+        //  best cells is found first does not change the target
+        world.for_each_region(xRegLb, numRegX, yRegLb, numRegY, [&](std::pair<int,int> reg){
+            const PreyLists* pLists = index.find(reg);
+            if(pLists == NULL) return;
+            pRegionLists.push_back(pLists);
+            numCellsInRegions += pLists->size();
+        });
+        if(numCellsInRegions > maxNumCells) return false;
+
+        // Same distances as get_nearest_cells(...)
+        int visionDist = stats["visionDist"][0], dia = get_dia();
+        int wrapUbX = WRAP_AROUND_X ? ubX.val : 0, wrapUbY = WRAP_AROUND_Y ? ubY.val : 0;
+        pTarget = NULL;
+        int maxRank = 0;
+        float minDistToTravel = 0;
+        bool isTied = false;
+        for(int category = 0; category < NUM_PREY_CATEGORIES; category++){
+            for(const PreyLists* pLists : pRegionLists){
+                if(pTarget != NULL && pLists->maxRankBases[category] < maxRank) continue;
+                for(Cell* pCell : pLists->cells[category]){
+                    if(pCell == pSelf) continue;
+                    if(pTarget != NULL && pCell->preyRankBase < maxRank) continue;
+                    int dX = wrap_offset(pCell->posX - posX, wrapUbX), dY = wrap_offset(pCell->posY - posY, wrapUbY);
+                    int sqDist = dX*dX + dY*dY;
+                    float effectiveVisionRadius = visionDist + (float)pCell->get_dia()/2;
+                    if(sqDist > ((double)effectiveVisionRadius + 1) * ((double)effectiveVisionRadius + 1)) continue;
+                    float distXY = std::sqrt(sqDist);
+                    if(distXY > effectiveVisionRadius) continue;
+                    int rank = calc_prey_rank(pCell);
+                    if(pTarget != NULL && rank < maxRank) continue;
+                    float distToTravel = max_float(distXY - (float)dia/2 - (float)pCell->get_dia()/2, 0);
+                    if(pTarget == NULL || rank > maxRank || distToTravel < minDistToTravel){
+                        pTarget = pCell;
+                        maxRank = rank;
+                        minDistToTravel = distToTravel;
+                        isTied = false;
+                    } else if(distToTravel == minDistToTravel){
+                        isTied = true;
+                    }
+                }
+            }
         }
-        // Get the optimal speedDir and speed for the first cell in the list
-        int cellIdToChase = nearestCellIds[0];
-        Cell* pTarget = get_pCell(cellIdToChase);
-        float effectiveDistFromTarget = calc_distance_from_point(pTarget->posX, pTarget->posY) - (float)(stats["dia"][0] + pTarget->stats["dia"][0]) / 2;
+        return !isTied;
+    }
+    // Pursue pTarget (see find_optimal_prey(...))
+    void chase_optimal_cell(Cell* pTarget, bool _doAttack, bool _doSelfDestruct, bool _doCloning){
+        //clear_forced_decisions();
+
         float targetDistance = calc_distance_from_point(pTarget->posX, pTarget->posY);
-        bool isTouchingTarget = ( targetDistance - (float)(stats["dia"][0] + pTarget->stats["dia"][0]) / 2 ) <= 0;
+        float effectiveDistFromTarget = targetDistance - (float)(get_dia() + pTarget->get_dia()) / 2;
+        bool isTouchingTarget = ( targetDistance - (float)(get_dia() + pTarget->get_dia()) / 2 ) <= 0;
         if(pTarget->isAlive == false && isTouchingTarget){
             set_ai_outputs(0, rand() % 360, IDLE_MODE, false, false, _doCloning);
             return;
         }
-        int xNext = pTarget->posX + pTarget->get_speed()*cos_deg(pTarget->speedDir);
-        int yNext = pTarget->posY + pTarget->get_speed()*sin_deg(pTarget->speedDir);
+        int xNext = pTarget->preyNextX, yNext = pTarget->preyNextY; // Ranking the target already predicted where it goes next
         int _speedDir = get_optimal_speedDir_to_point(xNext, yNext);
         // Pursue the relevant cell for 1 more frame
         //int targetDistance = calc_distance_from_point(pTarget->posX, pTarget->posY);
@@ -1371,25 +1955,33 @@ struct Cell {
         enforce_valid_cell(false);
         //print_scalar_vals("  cellId", uniqueCellNum, "_speedDir", _speedDir, "_speedMode", _speedMode, "xNext", xNext, "yNext", yNext,
         //    "_speedDir", _speedDir, "targetDistance", targetDistance, "targetSpeed", targetSpeed, "posX", posX, "posY", posY);
-
-        #undef get_pCell
     }
     void kill_self(){
         assert(isAlive);
+        // Move the cell from the alive counters to the dead counters
+        bool wasCounted = isCounted;
+        unregister_population();
         decayPeriod = 1;
         decayRate = 2;
         energy += energyCostToClone;
+        energyCostPerFrame = 0; // Dead cells do NOT consume energy (see update_energy_costs())
         timeSinceDead = 0;
         isAlive = false;
         speedMode = IDLE_MODE;
         clear_forced_decisions();
+        if(wasCounted) register_population();
+        lineageLog.record_death(uniqueCellNum, frameNum);
         //pActives.erase(pActives.begin() + i_pAlive);
         //pActives.push_back(pSelf);
     }
-    void remove_this_dead_cell_if_depleted(std::vector<Cell*>& pActives, int iDead){
-        if(isAlive || energy > 0) return;
+    // Returns true if the cell was removed from pActives, in which case the caller should free it
+    //  (its lineage is kept in lineageLog)
+    bool remove_this_dead_cell_if_depleted(std::vector<Cell*>& pActives, int iDead){
+        if(isAlive || energy > 0) return false;
         assert(pActives[iDead] == pSelf);
+        unregister_population();
         pActives.erase(pActives.begin() + iDead);
+        return true;
     }
     std::vector<int> findWeighting(int numSlots, int* arr, int arrSize){
         int sum = 0;
@@ -1418,69 +2010,33 @@ struct Cell {
         }
         return weights;
     }
-    std::vector<SDL_Texture*> findEAMTex(){
-        std::vector<SDL_Texture*> ans;
-        // First, check if everything is balanced
-        int minEAM = stats["EAM_SUN"][0];
-        minEAM = min_int(minEAM, stats["EAM_GND"][0]);
-        minEAM = min_int(minEAM, stats["EAM_CELLS"][0]);
-        int maxEAM = stats["EAM_SUN"][0];
-        maxEAM = max_int(maxEAM, stats["EAM_GND"][0]);
-        maxEAM = max_int(maxEAM, stats["EAM_CELLS"][0]);
-        if(maxEAM <= 2*minEAM){
-            ans.push_back(P_EAM_TEX["balanced"]);
-            return ans;
-        }
-        int numPixelsInEAMTex = 4;
-        int EAMPerPixel = REQ_EAM_SUM / numPixelsInEAMTex;
-        if(stats["EAM_GND"][0] < EAMPerPixel) ans.push_back(P_EAM_TEX["balanced"]);
-        else ans.push_back(P_EAM_TEX["g4"]); // Ground (or balanced) will fill in the empty spaces
-        // NOTE: there are 4 pixels to color in
-        // We only have to worry about the sun and predation textures, since the remaining
-        //  is already taken care of
-        if(stats["EAM_SUN"][0] / EAMPerPixel > 0){
-            std::string nextFile = "s" + std::to_string(stats["EAM_SUN"][0] / EAMPerPixel);
-            ans.push_back(P_EAM_TEX[nextFile]);
-        }
-        if(stats["EAM_CELLS"][0] / EAMPerPixel > 0){
-            std::string nextFile = "c" + std::to_string(stats["EAM_CELLS"][0] / EAMPerPixel);
-            ans.push_back(P_EAM_TEX[nextFile]);
+    // Everything draw_cell_snapshot(...) needs, so the cell can be drawn without touching it (see RenderSnapshot)
+    CellSnapshot get_snapshot(){
+        CellSnapshot snapshot;
+        snapshot.posX = posX;
+        snapshot.posY = posY;
+        snapshot.dia = get_dia();
+        snapshot.isAlive = isAlive;
+        if(isAlive){
+            snapshot.energyPct = energy * 100 / get_max_energy();
+            snapshot.healthPct = 100*health/get_max_health();
         }
-        return ans;
+        snapshot.showAttack = doAttack && stats["attack"][0] > 0; // Only searches the stats of attacking cells
+        snapshot.showCloning = doCloning;
+        for(int iEAM = 0; iEAM < NUM_EAM_ELE; iEAM++) snapshot.EAM[iEAM] = get_EAM(iEAM);
+        snapshot.visionDist = drawVisionRadius ? stats["visionDist"][0] : 0;
+        return snapshot;
     }
     void draw_cell(){
-        int drawX = drawScaleFactor*(posX + 0.5 - (float)stats["dia"][0]/2);
-        int drawY = drawScaleFactor*(posY + 0.5 - (float)stats["dia"][0]/2);
-        int drawSize = drawScaleFactor*stats["dia"][0];
-        if(!isAlive){ draw_texture(pDeadCellTex, drawX, drawY, drawSize, drawSize); return; }
-        draw_texture(pCellSkeleton, drawX, drawY, drawSize, drawSize, true);
-        // Draw the health and energy on top of this
-        SDL_Texture* energyTex = findSDLTex(energy * 100 / stats["maxEnergy"][0], P_CELL_ENERGY_TEX);
-        draw_texture(energyTex, drawX, drawY, drawSize, drawSize, true);
-        SDL_Texture* healthTex = findSDLTex(100*health/stats["maxHealth"][0], P_CELL_HEALTH_TEX);
-        draw_texture(healthTex, drawX, drawY, drawSize, drawSize, true);
-        if(doAttack && stats["attack"][0] > 0)  draw_texture(pDoAttackTex,  drawX, drawY, drawSize, drawSize, true);
-        if(doCloning) draw_texture(pDoCloningTex, drawX, drawY, drawSize, drawSize, true);
-        std::vector<SDL_Texture*> EAM_Tex = findEAMTex();
-        for(auto tex : EAM_Tex) draw_texture(tex, drawX, drawY, drawSize, drawSize, true);
-        if(drawVisionRadius && stats["visionDist"][0] > 0){
-            int drawCenterX = drawScaleFactor*(posX + 0.5);
-            int drawCenterY = drawScaleFactor*(posY + 0.5);
-            int drawRadius = stats["visionDist"][0]*drawScaleFactor;
-            SDL_Color white = {0xff, 0xff, 0xff, 0x20};
-            if(drawRadius >= min_int(ubX_px, ubY_px) / 2) white = {0xff, 0xff, 0xff, 0x05};
-            draw_regular_polygon(drawCenterX, drawCenterY, drawRadius, 32, white);
-            if(drawCenterY < drawRadius)                                                draw_regular_polygon(drawCenterX         , drawCenterY + ubY_px, drawRadius, 32, white);
-            if(drawCenterY > ubY_px - drawRadius)                                       draw_regular_polygon(drawCenterX         , drawCenterY - ubY_px, drawRadius, 32, white);
-            if(drawCenterX < drawRadius && true)                                        draw_regular_polygon(drawCenterX + ubX_px, drawCenterY         , drawRadius, 32, white);
-            if(drawCenterX < drawRadius && drawCenterY < drawRadius)                    draw_regular_polygon(drawCenterX + ubX_px, drawCenterY + ubY_px, drawRadius, 32, white);
-            if(drawCenterX < drawRadius && drawCenterY > ubY_px - drawRadius)           draw_regular_polygon(drawCenterX + ubX_px, drawCenterY - ubY_px, drawRadius, 32, white);
-            if(drawCenterX > ubX_px - drawRadius && true)                               draw_regular_polygon(drawCenterX - ubX_px, drawCenterY         , drawRadius, 32, white);
-            if(drawCenterX > ubX_px - drawRadius && drawCenterY < drawRadius)           draw_regular_polygon(drawCenterX - ubX_px, drawCenterY + ubY_px, drawRadius, 32, white);
-            if(drawCenterX > ubX_px - drawRadius && drawCenterY > ubY_px - drawRadius)  draw_regular_polygon(drawCenterX - ubX_px, drawCenterY - ubY_px, drawRadius, 32, white);
-        }
+        draw_cell_snapshot(get_snapshot());
     }
 };
+// The hot section has to stay within one cache line
+//  NOTE: Cell is not standard-layout (it has maps, etc.), but GCC still lays out its members in order
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+static_assert(offsetof(Cell, pSelf) <= 64, "The hot variables of Cell no longer fit in 64 bytes");
+#pragma GCC diagnostic pop
 
 
 